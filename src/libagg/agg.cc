@@ -41,7 +41,8 @@ isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
 cache(numPlayers+1),
 player2Class(numPlayers),
-kSymStrategyOffset(1,0)
+kSymStrategyOffset(1,0),
+pureTablesReady(false)
 {
   //use swap instead of copy; faster but destroys the input parameters.
   //payoffs.swap(_payoffs);
@@ -587,7 +588,6 @@ agg::computeP(int player, int act, int player2,int act2)
     
 }
 
-#ifdef USE_CVECTOR
 void agg:: computePartialP_PureNode(int player1,int act1, vector<int>& tasks){
     int i,j,Node = actionSets[player1][act1];
     int numNei = neighbors[Node].size();
@@ -635,15 +635,7 @@ void agg:: computePartialP_PureNode(int player1,int act1, vector<int>& tasks){
     }//end for(i
 
 }
-#endif
-
-#ifdef USE_CVECTOR
-void agg::computePartialP(int player1, int act1, vector<int>& tasks,vector<int>& nontasks){
-//TODO
-}
-#endif
 
-#ifdef USE_CVECTOR
 void agg::computePartialP_bisect(int player1,int act1,
     vector<int>::iterator start,vector<int>::iterator endp,
     aggdistrib& temp){
@@ -693,7 +685,6 @@ void agg::computePartialP_bisect(int player1,int act1,
   }
   
 }
-#endif
 
 
 void agg:: doProjection(int Node,const StrategyProfile& s)
@@ -722,19 +713,257 @@ Number agg::getPurePayoff(int player, int *s){
         (*projFunctions[Node][j]) (pureprofile[j],projection[Node][i][s[i]][j] );
     }
   }
-  aggpayoff::iterator p= payoffs[Node].find(pureprofile);
-  if ( p == payoffs[Node].end() ){
-    cout<<"agg::getPurePayoff ERROR: unable to find the following configuration"
+  return lookupPayoff(Node, pureprofile);
+}
+
+//getDenseIndex: the position of configuration c in the dense payoff
+//table of action node 'node', or -1 if there is no such entry
+long agg::getDenseIndex(int node, const config &c)
+{
+  if (!pureTablesReady || densePayoffs[node].empty()) return -1;
+  long ind=0;
+  for (size_t j=0;j<c.size();++j){
+    int v = c[j]-denseMin[node][j];
+    if (v<0) return -1;
+    ind += (long)v*denseStride[node][j];
+  }
+  return (ind<(long)densePayoffs[node].size())?ind:-1;
+}
+
+//lookupPayoff: the payoff at action node 'node' given the configuration c
+//of its neighborhood.  Uses the dense table where one has been built.
+Number agg::lookupPayoff(int node, const config &c)
+{
+  long ind = getDenseIndex(node,c);
+  if (ind>=0) return densePayoffs[node][ind];
+
+  aggpayoff::iterator p= payoffs[node].find(c);
+  if ( p == payoffs[node].end() ){
+    cout<<"agg::lookupPayoff ERROR: unable to find the following configuration"
         <<endl;
     cout <<"[";
-    copy(pureprofile.begin(),pureprofile.end(),ostream_iterator<int>(cout, " "));
+    copy(c.begin(),c.end(),ostream_iterator<int>(cout, " "));
     cout<<"]" <<endl;
-    cout<< "\tin payoffs of action node #"<<Node<<endl;
+    cout<< "\tin payoffs of action node #"<<node<<endl;
     exit(1);
   }
   return p->second;
 }
 
+//initPureTables: build the per-node tables used by aggpureprofile for
+//incremental evaluation of pure strategy profiles.
+//A dense payoff table is only built for an action node when the box
+//spanned by its configurations is at most MAX_DENSE_RATIO times the
+//number of configurations; the entries of the box that are not valid
+//configurations are never looked up for a valid profile.
+void agg::initPureTables()
+{
+  const double MAX_DENSE_RATIO = 8.0;
+  if (pureTablesReady) return;
+
+  getNodeContributions(nodeContrib);
+
+  multiset<int> none;
+  neutralContrib.assign(numActionNodes, config());
+  affectedNodes.assign(numActionNodes, vector<int>());
+  for (int Node=0;Node<numActionNodes;++Node){
+    int keylen = neighbors[Node].size();
+    for (int j=0;j<keylen;++j){
+      neutralContrib[Node].push_back((*projFunctions[Node][j])(none));
+    }
+    for (int s=0;s<numActionNodes;++s){
+      //nodes in no player's action set never contribute
+      if (nodeContrib[Node][s].empty()){
+        nodeContrib[Node][s] = neutralContrib[Node];
+      }
+      else if (nodeContrib[Node][s] != neutralContrib[Node]){
+        affectedNodes[s].push_back(Node);
+      }
+    }
+  }
+
+  densePayoffs.assign(numActionNodes, vector<Number>());
+  denseMin.assign(numActionNodes, config());
+  denseStride.assign(numActionNodes, config());
+  for (int Node=0;Node<numActionNodes;++Node){
+    if (payoffs[Node].empty()) continue;
+    int keylen = neighbors[Node].size();
+    config lo(payoffs[Node].begin()->first), hi(lo);
+    for (aggpayoff::iterator p=payoffs[Node].begin();p!=payoffs[Node].end();++p){
+      for (int j=0;j<keylen;++j){
+        lo[j]=min(lo[j],p->first[j]);
+        hi[j]=max(hi[j],p->first[j]);
+      }
+    }
+    double size=1;
+    for (int j=0;j<keylen;++j) size *= hi[j]-lo[j]+1;
+    if (size > MAX_DENSE_RATIO * payoffs[Node].size()) continue;
+
+    denseMin[Node]=lo;
+    denseStride[Node]=config(keylen);
+    long stride=1;
+    for (int j=keylen-1;j>=0;--j){
+      denseStride[Node][j]=stride;
+      stride *= hi[j]-lo[j]+1;
+    }
+    densePayoffs[Node].assign(stride, 0);
+  }
+  pureTablesReady = true;
+
+  //fill in the dense tables
+  for (int Node=0;Node<numActionNodes;++Node){
+    for (aggpayoff::iterator p=payoffs[Node].begin();p!=payoffs[Node].end();++p){
+      long ind = getDenseIndex(Node,p->first);
+      if (ind>=0) densePayoffs[Node][ind]=p->second;
+    }
+  }
+}
+
+//foldContribution: apply the contribution y of an action node k times
+//to the value x of a projected node.  Sums accumulate; the remaining
+//projection types are idempotent under repeated application.
+static inline int foldContribution(proj_func *f, int x, int y, int k)
+{
+  if (f->Type==P_SUM || f->Type==P_SUM2) return x+k*y;
+  return (k>0)?(*f)(x,y):x;
+}
+
+//getNodeContributions: foreach action node s, foreach action node s',
+//the contribution of s' to the configuration of s's neighborhood.
+//This only depends on s', not on the player choosing it.
+void agg::getNodeContributions(vector<vector<config> > &dest)
+{
+  dest.assign(numActionNodes, vector<config>(numActionNodes));
+  vector<bool> done(numActionNodes,false);
+  for (size_t cls=0;cls<playerClasses.size();++cls){
+    int player = playerClasses[cls][0];
+    for (int j=0;j<actions[player];++j)if(!done[actionSets[player][j]]){
+      for (int Node=0;Node<numActionNodes;++Node)
+        dest[Node][actionSets[player][j]]=projection[Node][player][j];
+      done[actionSets[player][j]]=true;
+    }
+  }
+}
+
+//getConfigPayoff: payoff to a player choosing action node 'node', when
+//nodeCount[s] players (including that player) choose each action node s
+Number agg::getConfigPayoff(int node, const vector<int> &nodeCount,
+    const vector<vector<config> > &contrib)
+{
+  int keylen = neighbors[node].size();
+  config c;
+  bool first = true;
+  for (int s=0;s<numActionNodes;++s)if(nodeCount[s]>0){
+    const config &cs = contrib[node][s];
+    int k = nodeCount[s];
+    if (first){
+      c = cs;
+      --k;
+      first = false;
+    }
+    for (int j=0;j<keylen;++j){
+      c[j] = foldContribution(projFunctions[node][j], c[j], cs[j], k);
+    }
+  }
+  return lookupPayoff(node,c);
+}
+
+//isPureNashConfig: check whether any player has a profitable unilateral
+//deviation from the class configuration cc.  nodeCount must be the
+//number of players on each action node under cc; it is restored on return.
+bool agg::isPureNashConfig(const ClassConfig &cc, vector<int> &nodeCount,
+    const vector<vector<config> > &contrib)
+{
+  for (size_t cls=0;cls<cc.size();++cls){
+    const ActionSet &as = uniqueActionSets[cls];
+    for (size_t a=0;a<as.size();++a)if(cc[cls][a]>0){
+      Number u = getConfigPayoff(as[a],nodeCount,contrib);
+      nodeCount[as[a]]--;
+      for (size_t b=0;b<as.size();++b)if(b!=a){
+        nodeCount[as[b]]++;
+        Number v = getConfigPayoff(as[b],nodeCount,contrib);
+        nodeCount[as[b]]--;
+        if (v>u){
+          nodeCount[as[a]]++;
+          return false;
+        }
+      }
+      nodeCount[as[a]]++;
+    }
+  }
+  return true;
+}
+
+//getPureNash: find all pure-strategy Nash equilibria.
+//Payoffs only depend on the number of players choosing each action node,
+//and players with identical action sets are interchangeable, so instead of
+//the pure strategy profiles we enumerate, foreach player class, the
+//compositions of the class size over the class's actions.  The classes are
+//advanced odometer-style, each by a Gray code (GrayComposition), so that
+//consecutive configurations differ by one player changing action.
+//Each equilibrium configuration is appended to dest.
+//Returns the number of configurations examined.
+long agg::getPureNash(vector<ClassConfig> &dest)
+{
+  int numClasses = playerClasses.size();
+  initPureTables();
+  const vector<vector<config> > &contrib = nodeContrib;
+
+  vector<GrayComposition> gc;
+  ClassConfig current(numClasses);
+  vector<int> nodeCount(numActionNodes,0);
+  for (int cls=0;cls<numClasses;++cls){
+    gc.push_back(GrayComposition(playerClasses[cls].size(),uniqueActionSets[cls].size()));
+    current[cls] = gc[cls].get();
+    nodeCount[uniqueActionSets[cls][0]] += playerClasses[cls].size();
+  }
+
+  long numConfigs = 0;
+  while (1){
+    ++numConfigs;
+    if (isPureNashConfig(current,nodeCount,contrib)){
+      dest.push_back(current);
+    }
+
+    //get next configuration
+    int cls;
+    for (cls=0;cls<numClasses;++cls){
+      gc[cls].incr();
+      if (!gc[cls].eof()){
+        //one player of class cls moves from action d to action i
+        nodeCount[uniqueActionSets[cls][gc[cls].d]]--;
+        nodeCount[uniqueActionSets[cls][gc[cls].i]]++;
+        current[cls] = gc[cls].get();
+        break;
+      }
+      //wrap around: put all players of class cls back on its first action
+      int numPl = playerClasses[cls].size();
+      for (size_t a=0;a<uniqueActionSets[cls].size();++a)
+        nodeCount[uniqueActionSets[cls][a]] -= current[cls][a];
+      gc[cls] = GrayComposition(numPl,uniqueActionSets[cls].size());
+      current[cls] = gc[cls].get();
+      nodeCount[uniqueActionSets[cls][0]] += numPl;
+    }
+    if (cls==numClasses) break;
+  }
+  return numConfigs;
+}
+
+//getPureProfile: a pure strategy profile (action index for each player)
+//realizing the class configuration cc
+void agg::getPureProfile(int *s, const ClassConfig &cc)
+{
+  for (size_t cls=0;cls<cc.size();++cls){
+    size_t k=0;
+    for (size_t a=0;a<cc[cls].size();++a){
+      for (int m=0;m<cc[cls][a];++m){
+        int player = playerClasses[cls].at(k++);
+        s[player] = node2Action[uniqueActionSets[cls][a]][player];
+      }
+    }
+  }
+}
+
 Number agg::getMixedPayoff(int player, StrategyProfile &s){
   Number result=0.0;
   assert(player>=0 && player < numPlayers);
@@ -765,8 +994,7 @@ Number agg::getJ(int player1, int act1, int player2,int act2,StrategyProfile &s)
     return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player1][act1]]);
 }
 
-#ifdef USE_CVECTOR
-void agg::payoffMatrix(cmatrix &dest, cvector &s, Number fuzz){
+void agg::payoffMatrix(Number **dest, const StrategyProfile &s, Number fuzz){
   //compute jacobian
   //s: mixed strat
 
@@ -861,7 +1089,10 @@ void agg::payoffMatrix(cmatrix &dest, cvector &s, Number fuzz){
 	    //compute partial prob distributions
 	    if (tasks.size()==0 && spares.size()==0) continue; //nothing to be done for this row
 
-	    if(isPure[currNode]||tasks.size()==0){
+	    //the partial distributions for tasks are always built by bisection:
+	    //dividing the full distribution by a player's projected strategy
+	    //loses accuracy when that strategy has small probabilities
+	    if(tasks.size()==0){
 	      computePartialP_PureNode(rown, act1,tasks);
 	    }else{//do bisection 
 	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),Pr[rown]);
@@ -950,9 +1181,7 @@ void agg::payoffMatrix(cmatrix &dest, cvector &s, Number fuzz){
 	}//end for(act1
   }//end for(rown
 }
-#endif
 
-#ifdef USE_CVECTOR
 void agg::computeUndisturbedPayoff(Number& undisturbedPayoff,bool& has,int player1,int act1,int player2)
 {
   if (has) return;
@@ -967,7 +1196,7 @@ void agg::computeUndisturbedPayoff(Number& undisturbedPayoff,bool& has,int playe
   }
   has=true;
 }
-void agg::savePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Number result,
+void agg::savePayoff(Number **dest,int player1,int act1,int player2,int act2,Number result,
 	trie_map<Number>& cache, bool partial ){
 
   int    Node =actionSets[player1][act1];
@@ -995,7 +1224,7 @@ void agg::savePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Num
   dest[act1+firstAction(player1)][act2+firstAction(player2)]=result;
   
 }
-void agg::computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,trie_map<Number>& cache){
+void agg::computePayoff(Number **dest,int player1,int act1,int player2,int act2,trie_map<Number>& cache){
   int    Node =actionSets[player1][act1];
   int    numNei= neighbors[Node].size();
 
@@ -1013,7 +1242,6 @@ void agg::computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,
     savePayoff(dest,player1,act1,player2,act2,r.first->second,cache,r.second);
   }
 }
-#endif
 
 //getSymMixedPayoff: compute expected payoff under a symmetric mixed strat,
 //  for a symmetric game.
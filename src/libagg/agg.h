@@ -60,9 +60,8 @@ public:
   static const char RBRACKET=']';
 
 
-#ifdef USE_CVECTOR
   friend class aggame;   //wrapper class for gametracer
-#endif
+  friend class aggpureprofile;   //incremental pure strategy profile
 
   //read an AGG from a file
   static agg* makeAGG(char* filename);
@@ -145,13 +144,20 @@ vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_factor=10
   Number getV (int player, int action,const StrategyProfile &s);
   Number getJ(int player,int action, int player2,int action2,StrategyProfile &s);
 
-#ifdef USE_CVECTOR
-  //compute payoff jacobian
-  void payoffMatrix(cmatrix &dest, cvector &s, Number fuzz);
-#endif
+  //compute payoff jacobian: dest[i] is the row for action i, 
+  //with one column per action
+  void payoffMatrix(Number **dest, const StrategyProfile &s, Number fuzz);
 
 
   Number getPurePayoff(int player, int *s);
+
+  //pure-strategy Nash equilibria, enumerated in the space of
+  //configurations of each player class:
+  //foreach player class, the number of players in the class choosing
+  //each action in the corresponding unique action set
+  typedef vector<config> ClassConfig;
+  long getPureNash(vector<ClassConfig> &dest);
+  void getPureProfile(int *s, const ClassConfig &cc);
   inline void printPayoffs( ostream & s, int node){
     s << payoffs[node].size()<<endl;
     s << payoffs[node];
@@ -285,6 +291,27 @@ private:
   //strategyOffset for kSymmetric strategy profile
   vector<int> kSymStrategyOffset;
 
+  //tables for incremental evaluation of pure strategy profiles,
+  //built on demand by initPureTables()
+  bool pureTablesReady;
+
+  //foreach s in S, foreach s' in S, the contribution of s' to D^(s)
+  vector<vector<config> > nodeContrib;
+
+  //foreach s in S, the contribution to D^(s) of an action node that
+  //does not affect s
+  vector<config> neutralContrib;
+
+  //foreach s' in S, the action nodes s to whose D^(s) s' contributes
+  vector<vector<int> > affectedNodes;
+
+  //foreach s in S, the payoffs stored densely by configuration, with the
+  //smallest value and the stride of each neighbor; empty if the
+  //configurations are too sparse for a dense table to pay off
+  vector<vector<Number> > densePayoffs;
+  vector<config> denseMin;
+  vector<config> denseStride;
+
 
   //input functor 
   struct input : public unary_function<aggpayoff::iterator , void>{
@@ -330,18 +357,25 @@ private:
   void  doProjection(int Node,const StrategyProfile& s);
   void doProjection(int Node, int player, const StrategyProfile& s);
 
-#ifdef USE_CVECTOR
   //helper functions for computing jacobian
   void computePartialP_PureNode(int player,int act,vector<int>& tasks);
   void computePartialP_bisect(int player,int act, vector<int>::iterator f,vector<int>::iterator l,aggdistrib& temp);
-  void computePartialP(int player1, int act1, vector<int>& tasks,vector<int>& nontasks);
-  void computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,trie_map<Number>& cache);
-  void savePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Number result,
+  void computePayoff(Number **dest,int player1,int act1,int player2,int act2,trie_map<Number>& cache);
+  void savePayoff(Number **dest,int player1,int act1,int player2,int act2,Number result,
 	trie_map<Number>& cache, bool partial=false );
   void computeUndisturbedPayoff(Number& undisturbedPayoff,bool& has,int player1,int act1,int player2);
-#endif
 
   void getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
+
+  //helper functions for pure strategy payoffs
+  void initPureTables();
+  long getDenseIndex(int node, const config &c);
+  Number lookupPayoff(int node, const config &c);
+
+  //helper functions for pure equilibrium computation
+  void getNodeContributions(vector<vector<config> > &dest);
+  Number getConfigPayoff(int node, const vector<int> &nodeCount, const vector<vector<config> > &contrib);
+  bool isPureNashConfig(const ClassConfig &cc, vector<int> &nodeCount, const vector<vector<config> > &contrib);
 };
 
 
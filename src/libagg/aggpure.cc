@@ -0,0 +1,145 @@
+using namespace std;
+
+#include <cassert>
+#include "aggpure.h"
+
+
+aggpureprofile::aggpureprofile(agg *g)
+:game(g), strat(g->getNumPlayers(),0)
+{
+  init(&strat[0]);
+}
+
+aggpureprofile::aggpureprofile(agg *g, const int *s)
+:game(g), strat(g->getNumPlayers(),0)
+{
+  init(s);
+}
+
+void aggpureprofile::init(const int *s)
+{
+  game->initPureTables();
+  int S = game->getNumActionNodes();
+  int n = game->getNumPlayers();
+
+  //start from every player making the neutral contribution
+  current.assign(S, agg::config());
+  counts.assign(S, vector<map<int,int> >());
+  for (int Node=0;Node<S;++Node){
+    int keylen = game->neighbors[Node].size();
+    current[Node] = game->neutralContrib[Node];
+    counts[Node].resize(keylen);
+    for (int j=0;j<keylen;++j)if(isInvertible(Node,j)){
+      current[Node][j] *= n;
+    }
+  }
+
+  for (int i=0;i<n;++i){
+    strat[i] = s[i];
+    int actNode = game->actionSets[i][s[i]];
+    for (size_t k=0;k<game->affectedNodes[actNode].size();++k){
+      applyContribution(game->affectedNodes[actNode][k], actNode, 1);
+    }
+  }
+}
+
+void aggpureprofile::setProfile(const int *s)
+{
+  for (int i=0;i<game->getNumPlayers();++i){
+    setAction(i,s[i]);
+  }
+}
+
+void aggpureprofile::setAction(int player, int act)
+{
+  int from = game->actionSets[player][strat[player]];
+  int to = game->actionSets[player][act];
+  strat[player] = act;
+  if (from==to) return;
+
+  for (size_t k=0;k<game->affectedNodes[from].size();++k){
+    applyContribution(game->affectedNodes[from][k], from, -1);
+  }
+  for (size_t k=0;k<game->affectedNodes[to].size();++k){
+    applyContribution(game->affectedNodes[to][k], to, 1);
+  }
+}
+
+//applyContribution: add (sign=1) or remove (sign=-1) the contribution of
+//one player choosing actNode to the configuration of node
+void aggpureprofile::applyContribution(int node, int actNode, int sign)
+{
+  const agg::config &c = game->nodeContrib[node][actNode];
+  const agg::config &z = game->neutralContrib[node];
+  for (size_t j=0;j<c.size();++j)if(c[j]!=z[j]){
+    if (isInvertible(node,j)){
+      current[node][j] += sign*(c[j]-z[j]);
+    }
+    else{
+      int &cnt = counts[node][j][c[j]];
+      cnt += sign;
+      assert(cnt>=0);
+      if (cnt==0) counts[node][j].erase(c[j]);
+      current[node][j] = foldEntry(node,j,z[j],z[j]);
+    }
+  }
+}
+
+//foldEntry: the value of a non-SUM entry of node's configuration, after one
+//player's contribution changes from 'from' to 'to' (from==to for the
+//current value).  Projections other than SUM are idempotent, so it suffices
+//to apply each distinct contribution once.
+int aggpureprofile::foldEntry(int node, int j, int from, int to) const
+{
+  proj_func *f = game->projFunctions[node][j];
+  int z = game->neutralContrib[node][j];
+  const map<int,int> &cnt = counts[node][j];
+  int numNeutral = game->getNumPlayers() - (from==z) + (to==z);
+  bool first = true, seenTo = (to==z);
+  int res = z;
+
+  for (map<int,int>::const_iterator p=cnt.begin();p!=cnt.end();++p){
+    numNeutral -= p->second;
+    int k = p->second - (p->first==from) + (p->first==to);
+    if (p->first==to) seenTo = true;
+    if (k>0){
+      res = first?p->first:(*f)(res,p->first);
+      first = false;
+    }
+  }
+  if (!seenTo){
+    res = first?to:(*f)(res,to);
+    first = false;
+  }
+  if (numNeutral>0){
+    res = first?z:(*f)(res,z);
+  }
+  return res;
+}
+
+Number aggpureprofile::getPayoff(int player) const
+{
+  int Node = game->actionSets[player][strat[player]];
+  return game->lookupPayoff(Node, current[Node]);
+}
+
+Number aggpureprofile::getDeviationPayoff(int player, int act) const
+{
+  int from = game->actionSets[player][strat[player]];
+  int to = game->actionSets[player][act];
+  if (from==to) return game->lookupPayoff(to, current[to]);
+
+  //move the player's contribution to the configuration of 'to'
+  const agg::config &cf = game->nodeContrib[to][from];
+  const agg::config &ct = game->nodeContrib[to][to];
+  scratch = current[to];
+  for (size_t j=0;j<scratch.size();++j)if(cf[j]!=ct[j]){
+    if (isInvertible(to,j)){
+      scratch[j] += ct[j]-cf[j];
+    }
+    else{
+      scratch[j] = foldEntry(to,j,cf[j],ct[j]);
+    }
+  }
+  return game->lookupPayoff(to, scratch);
+}
@@ -0,0 +1,57 @@
+// aggpure.h: incremental evaluation of pure strategy profiles of an AGG
+
+#ifndef __AGGPURE_H
+#define __AGGPURE_H
+
+#include <map>
+#include "agg.h"
+
+//aggpureprofile: a pure strategy profile of an AGG which maintains the
+//configuration of the neighborhood of every action node.
+//When one player changes action, only the action nodes to which the old or
+//the new action contributes are updated.  For SUM-type projections the
+//update is a subtraction and an addition; for the other projection types
+//(EXIST, HIGH, LOW) the number of players making each contribution is kept,
+//and the projected value is folded from these counts.
+//Payoffs are looked up in the dense tables built by agg::initPureTables()
+//where available.
+class aggpureprofile {
+public:
+  //all players choosing their first action
+  aggpureprofile(agg *g);
+  //the profile s, with s[i] the index of player i's action
+  aggpureprofile(agg *g, const int *s);
+
+  inline int getAction(int player) const {return strat[player];}
+  void setAction(int player, int act);
+  void setProfile(const int *s);
+
+  //payoff to player under the current profile
+  Number getPayoff(int player) const;
+  //payoff to player if it alone switched to action act
+  Number getDeviationPayoff(int player, int act) const;
+
+private:
+  agg *game;
+  vector<int> strat;
+
+  //foreach action node, the current configuration of its neighborhood
+  vector<agg::config> current;
+
+  //foreach action node, foreach neighbor with a non-SUM projection,
+  //the number of players making each non-neutral contribution
+  vector<vector<map<int,int> > > counts;
+
+  //scratch configuration for deviation payoffs
+  mutable agg::config scratch;
+
+  void init(const int *s);
+  inline bool isInvertible(int node, int j) const {
+    TypeEnum t = game->projFunctions[node][j]->Type;
+    return (t==P_SUM || t==P_SUM2);
+  }
+  void applyContribution(int node, int actNode, int sign);
+  int foldEntry(int node, int j, int from, int to) const;
+};
+
+#endif
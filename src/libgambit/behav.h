@@ -23,10 +23,14 @@
 #ifndef LIBGAMBIT_BEHAV_H
 #define LIBGAMBIT_BEHAV_H
 
+#include <vector>
+
 #include "game.h"
 
 namespace Gambit {
 
+class FlatGameTree;
+
 ///
 /// MixedBehavProfile<T> implements a randomized behavior profile on
 /// an extensive game.
@@ -36,6 +40,9 @@ protected:
   BehavSupport m_support;
 
   mutable bool m_cacheValid;
+  // information sets whose action probabilities have been written
+  // since the cache was computed; see InvalidateInfoset()
+  mutable std::vector<int> m_dirtyInfosets;
 
   // structures for storing cached data: nodes
   mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
@@ -47,6 +54,15 @@ protected:
   // structures for storing cached data: actions
   mutable DVector<T> m_actionValues;   // aka conditional payoffs
   mutable DVector<T> m_gripe;
+  // action probabilities, indexed by FlatGameTree action slots
+  mutable Array<T> m_actionProbs;
+  // information set probabilities, indexed by FlatGameTree infoset
+  mutable Array<T> m_infosetProbs;
+
+  // scratch space for incremental updates
+  mutable Array<int> m_infosetMarks;
+  mutable Array<bool> m_nodeMarks;
+  mutable std::vector<int> m_workNodes, m_workInfosets;
 
   const T &ActionValue(const GameAction &act) const 
     { return m_actionValues(act->GetInfoset()->GetPlayer()->GetNumber(),
@@ -59,11 +75,11 @@ protected:
   
   /// @name Auxiliary functions for computation of interesting values
   //@{
-  void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
-  
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
+  void ComputeActionProbs(const FlatGameTree &) const;
+  void ComputeRealizProbs(const FlatGameTree &) const;
   void ComputeSolutionData(void) const;
+  void UpdateSolutionData(const FlatGameTree &) const;
+  void UpdateActionValues(const FlatGameTree &, int) const;
   //@}
 
   /// @name Converting mixed strategies to behavior
@@ -112,7 +128,7 @@ public:
   const T &operator()(int a, int b, int c) const
     { return DVector<T>::operator()(a, b, c); }
   T &operator()(int a, int b, int c) 
-    { Invalidate();  return DVector<T>::operator()(a, b, c); }
+    { InvalidateInfoset(a, b);  return DVector<T>::operator()(a, b, c); }
   const T &operator[](int a) const
     { return Array<T>::operator[](a); }
   T &operator[](int a)
@@ -132,6 +148,15 @@ public:
   //@{
   /// Force recomputation of stored quantities
   void Invalidate(void) const { m_cacheValid = false; }
+  /// \brief Note a change to the action probabilities at one information set
+  ///
+  /// Rather than discarding the cached quantities, the next query
+  /// recomputes only those affected by the change: values along the
+  /// paths from the information set's members to the root, and
+  /// probabilities and beliefs in the subtrees below its members.
+  /// Writing a probability via operator()(pl, iset, act) or
+  /// operator()(action) calls this automatically.
+  void InvalidateInfoset(int pl, int iset) const;
   /// Set the profile to the centroid
   void Centroid(void);
   //@}
@@ -159,6 +184,15 @@ public:
   const T &GetActionValue(const GameAction &act) const;
   const T &GetRegret(const GameAction &act) const;
 
+  /// Returns the values of all actions, indexed by player, information
+  /// set, and action number
+  const DVector<T> &GetActionValues(void) const
+    { ComputeSolutionData();  return m_actionValues; }
+  /// Returns the values of all information sets, indexed by player and
+  /// information set number
+  const PVector<T> &GetInfosetValues(void) const
+    { ComputeSolutionData();  return m_infosetValues; }
+
   T DiffActionValue(const GameAction &action, 
 		    const GameAction &oppAction) const;
   T DiffRealizProb(const GameNode &node, 
@@ -928,7 +928,7 @@ void ParseEfg(GameParserState &p_state, Game p_game, TreeData &p_treeData)
 namespace Gambit {
 
 //=========================================================================
-//    ReadGame: Global visible function to read an .efg or .nfg file
+//    ReadGame: Global visible function to read an .efg, .nfg or .agg file
 //=========================================================================
 
 Game ReadGame(std::istream &p_file) throw (InvalidFileException)
@@ -952,6 +952,11 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
       game->Canonicalize();
       return game;
     }
+    else if (parser.GetLastText() == "#AGG") {
+      // The header is a comment as far as the AGG format is concerned;
+      // the remainder of the stream is passed on as-is.
+      return GameAggRep::ReadAggFile(p_file);
+    }
     else {
       throw InvalidFileException();
     }
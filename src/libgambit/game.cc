@@ -346,7 +346,7 @@ void GamePlayerRep::MakeReducedStrats(GameTreeNodeRep *n, GameTreeNodeRep *nn)
   }
   else if (nn)  {
     for (; ; nn = nn->m_parent->ptr->whichbranch)  {
-      m = dynamic_cast<GameTreeNodeRep *>(nn->GetNextSibling().operator->());
+      m = dynamic_cast<GameTreeNodeRep *>((GameNodeRep *) nn->GetNextSibling());
       if (m || nn->m_parent->ptr == NULL)   break;
     }
     if (m)  {
@@ -48,6 +48,8 @@ public:
   //@{
   /// Constructor; initializes reference count
   GameObject(void) : m_refCount(0), m_valid(true) { }
+  /// Destructor; virtual, since Invalidate() deletes through this class
+  virtual ~GameObject() { }
   //@}
 
   /// @name Validation
@@ -357,6 +359,7 @@ class GameStrategyRep : public GameObject  {
   friend class TablePureStrategyProfileRep;
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
+  template <class T> friend class TreeMixedStrategyProfileRep;
   template <class T> friend class MixedBehavProfile;
 
 private:
@@ -731,7 +734,8 @@ typedef GameObjectPtr<GameRep> Game;
 /// Factory function to create new game tree
 Game NewTree(void);
 /// Factory function to create new game table
-Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false,
+	      bool p_sparseTable = false);
 
 //=======================================================================
 //          Inline members of game representation classes
@@ -25,6 +25,7 @@
 
 #include "libgambit.h"
 #include "gameagg.h"
+#include "aggpure.h"
 
 namespace Gambit {
 
@@ -36,6 +37,8 @@ class AggPureStrategyProfileRep : public PureStrategyProfileRep {
 
 protected:
   long m_index;
+  /// Incrementally maintained configurations, for fast payoff lookups
+  aggpureprofile m_aggProfile;
 
 public:
   AggPureStrategyProfileRep(const Game &p_game);
@@ -53,6 +56,7 @@ public:
 //------------------------------------------------------------------------
 
 AggPureStrategyProfileRep::AggPureStrategyProfileRep(const Game &p_game)
+  : m_aggProfile(dynamic_cast<GameAggRep &>(*p_game).aggPtr)
 {
   m_index = 1L;
   m_nfg = p_game;
@@ -75,6 +79,7 @@ void AggPureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 {
   //m_index += s->m_offset - m_profile[s->GetPlayer()->GetNumber()]->m_offset;
   m_profile[s->GetPlayer()->GetNumber()] = s;
+  m_aggProfile.setAction(s->GetPlayer()->GetNumber() - 1, s->GetNumber() - 1);
 }
 
 GameOutcome AggPureStrategyProfileRep::GetOutcome(void) const
@@ -89,25 +94,14 @@ void AggPureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 
 Rational AggPureStrategyProfileRep::GetPayoff(int pl) const
 {
-	agg* aggPtr = dynamic_cast<GameAggRep &>(*m_nfg).aggPtr;
-	int s[aggPtr->getNumPlayers()];
-	for(int p=1; p<=aggPtr->getNumPlayers(); ++p){
-		s[p-1] = m_profile[p]->GetNumber() -1;
-	}
-	return aggPtr->getPurePayoff(pl-1,s);
+  return m_aggProfile.getPayoff(pl-1);
 }
 
 Rational
 AggPureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  agg* aggPtr = dynamic_cast<GameAggRep &>(*m_nfg).aggPtr;
-  int s[aggPtr->getNumPlayers()];
-  for(int p=1; p<=aggPtr->getNumPlayers(); ++p){
-  		s[p-1] = m_profile[p]->GetNumber() -1;
-  }
-  s[player-1] = p_strategy->GetNumber() -1;
-  return aggPtr->getPurePayoff(player-1,s);
+  return m_aggProfile.getDeviationPayoff(player-1, p_strategy->GetNumber()-1);
 }
 
 
@@ -155,6 +149,9 @@ void GameAggRep::WriteNfgFile(std::ostream &s) const{
 }
 void GameAggRep::WriteAggFile(std::ostream &s) const{
 
+	  //header, recognized by ReadGame()
+	  s<<"#AGG"<<endl;
+
 	  //num players
 
 	  s<<aggPtr->getNumPlayers()<<endl;
@@ -64,6 +64,8 @@ public:
 
   /// Create a copy of the game, as a new game
   virtual Game Copy(void) const;
+  /// Returns the underlying action-graph game representation
+  agg *GetUnderlyingAGG(void) const { return aggPtr; }
   //@}
 
   /// @name Dimensions of the game
@@ -67,9 +67,10 @@ PureStrategyProfile TablePureStrategyProfileRep::Copy(void) const
   return PureStrategyProfile(new TablePureStrategyProfileRep(*this));
 }
 
-Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes /*= false*/)
+Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes /*= false*/,
+	      bool p_sparseTable /*= false*/)
 {
-  return new GameTableRep(p_dim, p_sparseOutcomes);
+  return new GameTableRep(p_dim, p_sparseOutcomes, p_sparseTable);
 }
 
 //------------------------------------------------------------------------
@@ -84,17 +85,17 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  return dynamic_cast<GameTableRep &>(*m_nfg).GetResult(m_index); 
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  dynamic_cast<GameTableRep &>(*m_nfg).SetResult(m_index, p_outcome); 
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).GetResult(m_index);
   if (outcome) {
     return outcome->GetPayoff<Rational>(pl);
   }
@@ -107,7 +108,7 @@ Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).GetResult(m_index - m_profile[player]->m_offset + p_strategy->m_offset);
   if (outcome) {
     return outcome->GetPayoff<Rational>(player);
   }
@@ -141,9 +142,13 @@ int Product(const Array<int> &dim)
 
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
-			   bool p_sparseOutcomes /* = false */)
+			   bool p_sparseOutcomes /* = false */,
+			   bool p_sparseTable /* = false */)
+  : m_sparse(p_sparseTable), m_defaultOutcome(0)
 {
-  m_results = Array<GameOutcomeRep *>(Product(dim));
+  if (!m_sparse) {
+    m_results = Array<GameOutcomeRep *>(Product(dim));
+  }
   for (int pl = 1; pl <= dim.Length(); pl++)  {
     m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
     m_players[pl]->m_label = lexical_cast<std::string>(pl);
@@ -153,6 +158,11 @@ GameTableRep::GameTableRep(const Array<int> &dim,
   }
   IndexStrategies();
 
+  if (m_sparse) {
+    // All contingencies take the (null) default outcome
+    return;
+  }
+
   if (p_sparseOutcomes) {
     for (int cont = 1; cont <= m_results.Length();
 	 m_results[cont++] = 0);
@@ -171,7 +181,11 @@ Game GameTableRep::Copy(void) const
   std::ostringstream os;
   WriteNfgFile(os);
   std::istringstream is(os.str());
-  return ReadGame(is);
+  Game game = ReadGame(is);
+  if (m_sparse) {
+    dynamic_cast<GameTableRep &>(*game).SetSparse(true);
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -244,10 +258,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
   p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
 
-  int ncont = 1;
-  for (int i = 1; i <= NumPlayers(); i++) {
-    ncont *= m_players[i]->m_strategies.Length();
-  }
+  long ncont = NumContingencies();
 
   p_file << "{\n";
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
@@ -265,9 +276,10 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   }
   p_file << "}\n";
   
-  for (int cont = 1; cont <= ncont; cont++)  {
-    if (m_results[cont] != 0) {
-      p_file << m_results[cont]->m_number << ' ';
+  for (long cont = 1; cont <= ncont; cont++)  {
+    GameOutcomeRep *outcome = GetResult(cont);
+    if (outcome != 0) {
+      p_file << outcome->m_number << ' ';
     }
     else {
       p_file << "0 ";
@@ -289,6 +301,7 @@ GamePlayer GameTableRep::NewPlayer(void)
   for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
     m_outcomes[outc]->m_payoffs.Append(Number());
   }
+  IndexStrategies();
   ClearComputedValues();
   return player;
 }
@@ -299,9 +312,28 @@ GamePlayer GameTableRep::NewPlayer(void)
 
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
-  for (int i = 1; i <= m_results.Length(); i++) {
-    if (m_results[i] == p_outcome) {
-      m_results[i] = 0;
+  if (m_sparse) {
+    if (m_defaultOutcome == p_outcome) {
+      m_defaultOutcome = 0;
+    }
+    std::map<long, GameOutcomeRep *>::iterator cell = m_cells.begin();
+    while (cell != m_cells.end()) {
+      if (cell->second == p_outcome) {
+	cell->second = 0;
+      }
+      if (cell->second == m_defaultOutcome) {
+	m_cells.erase(cell++);
+      }
+      else {
+	++cell;
+      }
+    }
+  }
+  else {
+    for (int i = 1; i <= m_results.Length(); i++) {
+      if (m_results[i] == p_outcome) {
+	m_results[i] = 0;
+      }
     }
   }
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
@@ -311,6 +343,80 @@ void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
   ClearComputedValues();
 }
 
+//------------------------------------------------------------------------
+//                 GameTableRep: Sparse storage of contingencies
+//------------------------------------------------------------------------
+
+void GameTableRep::SetSparse(bool p_sparse)
+{
+  if (p_sparse == m_sparse) return;
+
+  if (p_sparse) {
+    // Take the most frequently occurring outcome as the default
+    std::map<GameOutcomeRep *, long> counts;
+    for (int i = 1; i <= m_results.Length(); i++) {
+      counts[m_results[i]]++;
+    }
+    m_defaultOutcome = 0;
+    long best = 0L;
+    for (std::map<GameOutcomeRep *, long>::const_iterator count = counts.begin();
+	 count != counts.end(); ++count) {
+      if (count->second > best) {
+	m_defaultOutcome = count->first;
+	best = count->second;
+      }
+    }
+
+    m_cells.clear();
+    for (int i = 1; i <= m_results.Length(); i++) {
+      if (m_results[i] != m_defaultOutcome) {
+	m_cells[i] = m_results[i];
+      }
+    }
+    m_results = Array<GameOutcomeRep *>();
+  }
+  else {
+    m_results = Array<GameOutcomeRep *>(NumContingencies());
+    for (int i = 1; i <= m_results.Length(); m_results[i++] = m_defaultOutcome);
+    for (std::map<long, GameOutcomeRep *>::const_iterator cell = m_cells.begin();
+	 cell != m_cells.end(); ++cell) {
+      m_results[cell->first] = cell->second;
+    }
+    m_cells.clear();
+    m_defaultOutcome = 0;
+  }
+
+  m_sparse = p_sparse;
+}
+
+GameOutcome GameTableRep::GetDefaultOutcome(void) const
+{
+  if (!m_sparse)  throw UndefinedException();
+  return m_defaultOutcome;
+}
+
+void GameTableRep::SetDefaultOutcome(const GameOutcome &p_outcome)
+{
+  if (!m_sparse)  throw UndefinedException();
+  m_defaultOutcome = p_outcome;
+  std::map<long, GameOutcomeRep *>::iterator cell = m_cells.begin();
+  while (cell != m_cells.end()) {
+    if (cell->second == m_defaultOutcome) {
+      m_cells.erase(cell++);
+    }
+    else {
+      ++cell;
+    }
+  }
+  ClearComputedValues();
+}
+
+long GameTableRep::NumStoredContingencies(void) const
+{
+  if (!m_sparse)  throw UndefinedException();
+  return m_cells.size();
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Factory functions
 //------------------------------------------------------------------------
@@ -334,6 +440,50 @@ MixedStrategyProfile<Rational> GameTableRep::NewMixedStrategyProfile(const Ratio
 /// numbered -1 are identified as the new strategies.
 void GameTableRep::RebuildTable(void)
 {
+  if (m_sparse) {
+    // Map the position of each surviving strategy in the old layout
+    // onto its number in the new one; only stored cells are visited.
+    Array<Array<int> > position(m_players.Length());
+    long oldOffset = 1L, newOffset = 1L;
+    Array<long> offsets(m_players.Length());
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      position[pl] = Array<int>(m_dims[pl]);
+      for (int i = 1; i <= m_dims[pl]; position[pl][i++] = 0);
+      for (int st = 1; st <= m_players[pl]->NumStrategies(); st++) {
+	GameStrategyRep *strategy = m_players[pl]->m_strategies[st];
+	if (strategy->m_offset >= 0) {
+	  position[pl][strategy->m_offset / oldOffset + 1] = strategy->m_number;
+	}
+      }
+      offsets[pl] = newOffset;
+      oldOffset *= m_dims[pl];
+      newOffset *= m_players[pl]->NumStrategies();
+    }
+
+    std::map<long, GameOutcomeRep *> newCells;
+    for (std::map<long, GameOutcomeRep *>::const_iterator cell = m_cells.begin();
+	 cell != m_cells.end(); ++cell) {
+      long key = cell->first - 1L, newindex = 1L;
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	int st = position[pl][key % m_dims[pl] + 1];
+	if (st == 0) {
+	  // This contingency involves a strategy no longer in the game
+	  newindex = -1L;
+	  break;
+	}
+	newindex += (st - 1) * offsets[pl];
+	key /= m_dims[pl];
+      }
+      if (newindex >= 1) {
+	newCells[newindex] = cell->second;
+      }
+    }
+
+    m_cells.swap(newCells);
+    IndexStrategies();
+    return;
+  }
+
   long size = 1L;
   Array<long> offsets(m_players.Length());
   for (int pl = 1; pl <= m_players.Length(); pl++) {
@@ -381,11 +531,44 @@ void GameTableRep::IndexStrategies(void)
     offset *= m_players[pl]->NumStrategies();
   }
 
+  m_dims = Array<int>(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    m_dims[pl] = m_players[pl]->NumStrategies();
+  }
+
   for (int pl = 1, id = 1; pl <= m_players.Length(); pl++) {
     for (int st = 1; st <= m_players[pl]->m_strategies.Length(); 
 	 m_players[pl]->m_strategies[st++]->m_id = id++);
   }
 }
 
+long GameTableRep::NumContingencies(void) const
+{
+  long size = 1L;
+  for (int pl = 1; pl <= m_dims.Length(); size *= m_dims[pl++]);
+  return size;
+}
+
+GameOutcomeRep *GameTableRep::GetResult(long p_index) const
+{
+  if (!m_sparse) {
+    return m_results[p_index];
+  }
+  std::map<long, GameOutcomeRep *>::const_iterator cell = m_cells.find(p_index);
+  return (cell != m_cells.end()) ? cell->second : m_defaultOutcome;
+}
+
+void GameTableRep::SetResult(long p_index, GameOutcomeRep *p_outcome)
+{
+  if (!m_sparse) {
+    m_results[p_index] = p_outcome;
+  }
+  else if (p_outcome == m_defaultOutcome) {
+    m_cells.erase(p_index);
+  }
+  else {
+    m_cells[p_index] = p_outcome;
+  }
+}
 
 }  // end namespace Gambit
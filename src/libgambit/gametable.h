@@ -23,6 +23,8 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <map>
+
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -32,20 +34,38 @@ class GameTableRep : public GameExplicitRep {
   friend class TablePureStrategyProfileRep;
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
+  /// Outcome of each contingency, indexed densely (unused if sparse)
   Array<GameOutcomeRep *> m_results;
+  /// Number of strategies per player in the current table layout
+  Array<int> m_dims;
+  /// Whether contingencies are stored sparsely
+  bool m_sparse;
+  /// In sparse mode, the outcome of any contingency not in m_cells
+  GameOutcomeRep *m_defaultOutcome;
+  /// In sparse mode, contingencies whose outcome differs from the default
+  std::map<long, GameOutcomeRep *> m_cells;
 
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  /// Returns the number of contingencies in the table
+  long NumContingencies(void) const;
+  /// Returns the outcome at the contingency with the given index
+  GameOutcomeRep *GetResult(long p_index) const;
+  /// Sets the outcome at the contingency with the given index
+  void SetResult(long p_index, GameOutcomeRep *p_outcome);
   //@}
 
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new table game with the given dimension
-  /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
-  GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+  /// If p_sparseOutcomes = true, outcomes for all contingencies are left null.
+  /// If p_sparseTable = true, the table is created in sparse storage mode
+  /// (see SetSparse()), with all contingencies null.
+  GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false,
+	       bool p_sparseTable = false);
   virtual Game Copy(void) const;
   //@}
 
@@ -105,6 +125,29 @@ public:
   virtual void DeleteOutcome(const GameOutcome &);
   //@}
 
+  /// @name Sparse storage of contingencies
+  //@{
+  /// Returns true if the table is stored in sparse mode
+  bool IsSparse(void) const { return m_sparse; }
+  /// \brief Switches between dense and sparse storage of the table
+  ///
+  /// In sparse mode, only contingencies whose outcome differs from
+  /// a default outcome are stored.  When switching to sparse mode,
+  /// the most common outcome in the table becomes the default.
+  /// Mixed profile payoffs are then computed by summing over the
+  /// stored contingencies only.
+  void SetSparse(bool p_sparse);
+  /// Returns the default outcome (sparse mode only)
+  GameOutcome GetDefaultOutcome(void) const;
+  /// \brief Sets the default outcome (sparse mode only)
+  ///
+  /// All contingencies not explicitly assigned a different outcome
+  /// take on the new default.
+  void SetDefaultOutcome(const GameOutcome &p_outcome);
+  /// Returns the number of contingencies explicitly stored (sparse mode only)
+  long NumStoredContingencies(void) const;
+  //@}
+
   /// @name Writing data files
   //@{
   virtual void WriteNfgFile(std::ostream &) const;
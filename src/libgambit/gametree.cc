@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "libgambit.h"
 #include "gametree.h"
@@ -35,6 +36,7 @@ namespace Gambit {
 GameTreeRep::GameTreeRep(void)
 {
   m_computedValues = false;
+  m_flatTree = 0;
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
 }
@@ -43,6 +45,7 @@ GameTreeRep::~GameTreeRep()
 {
   m_root->Invalidate();
   m_chance->Invalidate();
+  delete m_flatTree;
 }
 
 Game GameTreeRep::Copy(void) const
@@ -224,6 +227,8 @@ void GameTreeRep::ClearComputedValues(void) const
   }
 
   m_computedValues = false;
+  delete m_flatTree;
+  m_flatTree = 0;
 }
 
 void GameTreeRep::BuildComputedValues(void)
@@ -244,6 +249,108 @@ void GameTreeRep::BuildComputedValues(void)
   m_computedValues = true;
 }
 
+const FlatGameTree &GameTreeRep::GetFlatTree(void) const
+{
+  if (m_flatTree)  return *m_flatTree;
+
+  FlatGameTree *flat = new FlatGameTree;
+
+  // Number information sets globally, with chance's first, and lay
+  // out their actions and members contiguously.
+  flat->m_infosetOffset = Array<int>(0, m_players.Length());
+  int numInfosets = 0, numMembers = 0;
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    flat->m_infosetOffset[pl] = numInfosets;
+    numInfosets += player->m_infosets.Length();
+  }
+  flat->m_infosets = Array<GameTreeInfosetRep *>(numInfosets);
+  flat->m_infosetPlayer = Array<int>(numInfosets);
+  flat->m_slotStart = Array<int>(numInfosets + 1);
+  flat->m_memberStart = Array<int>(numInfosets + 1);
+  flat->m_slotStart[1] = 0;
+  flat->m_memberStart[1] = 1;
+  for (int pl = 0, i = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++, i++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      flat->m_infosets[i] = infoset;
+      flat->m_infosetPlayer[i] = pl;
+      flat->m_slotStart[i+1] = flat->m_slotStart[i] + infoset->m_actions.Length();
+      flat->m_memberStart[i+1] = flat->m_memberStart[i] + infoset->m_members.Length();
+      numMembers += infoset->m_members.Length();
+    }
+  }
+  flat->m_slotInfoset = Array<int>(flat->NumSlots());
+  for (int i = 1; i <= numInfosets; i++) {
+    for (int act = 1; act <= flat->NumActions(i); act++) {
+      flat->m_slotInfoset[flat->GetSlot(i, act)] = i;
+    }
+  }
+
+  // Number nodes in depth-first preorder, as NumberNodes() does, but
+  // without recursion so that deep trees can be handled.
+  std::vector<GameTreeNodeRep *> nodes(1, (GameTreeNodeRep *) 0);
+  std::vector<GameTreeNodeRep *> stack(1, m_root);
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+    node->number = nodes.size();
+    nodes.push_back(node);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+    }
+  }
+
+  int numNodes = nodes.size() - 1;
+  flat->m_parent = Array<int>(numNodes);
+  flat->m_infoset = Array<int>(numNodes);
+  flat->m_priorAction = Array<int>(numNodes);
+  flat->m_priorSlot = Array<int>(numNodes);
+  flat->m_outcomes = Array<GameOutcomeRep *>(numNodes);
+  flat->m_childStart = Array<int>(numNodes + 1);
+  flat->m_children = Array<int>(numNodes - 1);
+  flat->m_priorAction[1] = flat->m_priorSlot[1] = 0;
+  flat->m_childStart[1] = 1;
+
+  for (int n = 1; n <= numNodes; n++) {
+    GameTreeNodeRep *node = nodes[n];
+    flat->m_parent[n] = (node->m_parent) ? node->m_parent->number : 0;
+    flat->m_outcomes[n] = node->outcome;
+    flat->m_infoset[n] = 0;
+    if (node->infoset) {
+      flat->m_infoset[n] = 
+	flat->GetInfosetIndex(node->infoset->m_player->m_number,
+			      node->infoset->m_number);
+    }
+    flat->m_childStart[n+1] = flat->m_childStart[n] + node->children.Length();
+    for (int i = 1; i <= node->children.Length(); i++) {
+      int child = node->children[i]->number;
+      flat->m_children[flat->m_childStart[n] + i - 1] = child;
+      flat->m_priorAction[child] = i;
+      flat->m_priorSlot[child] = flat->GetSlot(flat->m_infoset[n], i);
+    }
+  }
+
+  flat->m_lastDescendant = Array<int>(numNodes);
+  for (int n = numNodes; n >= 1; n--) {
+    int numChildren = flat->NumChildren(n);
+    flat->m_lastDescendant[n] = 
+      (numChildren) ? flat->m_lastDescendant[flat->GetChild(n, numChildren)] : n;
+  }
+
+  flat->m_members = Array<int>(numMembers);
+  for (int i = 1; i <= numInfosets; i++) {
+    GameTreeInfosetRep *infoset = flat->m_infosets[i];
+    for (int k = 1; k <= infoset->m_members.Length(); k++) {
+      flat->m_members[flat->m_memberStart[i] + k - 1] = infoset->m_members[k]->number;
+    }
+  }
+
+  m_flatTree = flat;
+  return *m_flatTree;
+}
+
 //------------------------------------------------------------------------
 //                  GameTreeRep: Writing data files
 //------------------------------------------------------------------------
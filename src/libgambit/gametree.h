@@ -165,6 +165,86 @@ public:
 };
 
 
+/// \brief An immutable, array-based snapshot of a game tree
+///
+/// Nodes are indexed by their numbers, which after canonicalization
+/// follow a depth-first preorder; every node therefore has a larger
+/// index than its parent, and a pass in increasing (decreasing) order
+/// visits parents before (after) their children.  Information sets,
+/// including chance's, are numbered globally, and each action is
+/// given a "slot" so that per-action data can be kept in one vector.
+///
+/// The snapshot is built on demand by GameTreeRep::GetFlatTree(),
+/// and discarded whenever the tree changes.  Outcomes and chance
+/// probabilities are referenced rather than copied, so changes to
+/// payoffs are seen without rebuilding.
+class FlatGameTree {
+  friend class GameTreeRep;
+private:
+  Array<int> m_parent, m_infoset, m_priorAction, m_priorSlot, m_lastDescendant;
+  Array<int> m_childStart, m_children;
+  Array<GameOutcomeRep *> m_outcomes;
+
+  Array<GameTreeInfosetRep *> m_infosets;
+  Array<int> m_infosetPlayer, m_slotStart, m_slotInfoset;
+  Array<int> m_memberStart, m_members;
+  Array<int> m_infosetOffset;
+
+  FlatGameTree(void) { }
+
+public:
+  /// @name Nodes
+  //@{
+  /// Returns the number of nodes in the tree
+  int NumNodes(void) const { return m_parent.Length(); }
+  /// Returns the parent of the node (0 for the root)
+  int GetParent(int n) const { return m_parent[n]; }
+  /// Returns the global information set at the node (0 if terminal)
+  int GetInfoset(int n) const { return m_infoset[n]; }
+  /// Returns the number of the action leading to the node (0 for the root)
+  int GetPriorAction(int n) const { return m_priorAction[n]; }
+  /// Returns the slot of the action leading to the node (0 for the root)
+  int GetPriorSlot(int n) const { return m_priorSlot[n]; }
+  /// Returns the number of children of the node
+  int NumChildren(int n) const 
+    { return m_childStart[n+1] - m_childStart[n]; }
+  /// Returns the i'th child of the node
+  int GetChild(int n, int i) const { return m_children[m_childStart[n] + i - 1]; }
+  /// \brief Returns the highest-numbered node in the node's subtree
+  ///
+  /// The subtree of node n consists of exactly the nodes numbered from
+  /// n to GetLastDescendant(n).
+  int GetLastDescendant(int n) const { return m_lastDescendant[n]; }
+  /// Returns the outcome at the node (may be null)
+  GameOutcomeRep *GetOutcome(int n) const { return m_outcomes[n]; }
+  //@}
+
+  /// @name Information sets and actions
+  //@{
+  /// Returns the number of information sets, including chance's
+  int NumInfosets(void) const { return m_infosets.Length(); }
+  /// Returns the global number of the player's iset'th information set
+  int GetInfosetIndex(int pl, int iset) const
+    { return m_infosetOffset[pl] + iset; }
+  /// Returns the information set with the given global number
+  GameTreeInfosetRep *GetInfosetRep(int i) const { return m_infosets[i]; }
+  /// Returns the player at the information set (0 for chance)
+  int GetInfosetPlayer(int i) const { return m_infosetPlayer[i]; }
+  /// Returns the number of actions at the information set
+  int NumActions(int i) const { return m_slotStart[i+1] - m_slotStart[i]; }
+  /// Returns the slot of the act'th action at the information set
+  int GetSlot(int i, int act) const { return m_slotStart[i] + act; }
+  /// Returns the total number of action slots
+  int NumSlots(void) const { return m_slotStart[m_slotStart.Last()]; }
+  /// Returns the information set of the action in the slot
+  int GetSlotInfoset(int slot) const { return m_slotInfoset[slot]; }
+  /// Returns the number of members of the information set
+  int NumMembers(int i) const { return m_memberStart[i+1] - m_memberStart[i]; }
+  /// Returns the k'th member of the information set
+  int GetMember(int i, int k) const { return m_members[m_memberStart[i] + k - 1]; }
+  //@}
+};
+
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
@@ -172,6 +252,7 @@ protected:
   mutable bool m_computedValues;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  mutable FlatGameTree *m_flatTree;
 
   /// @name Private auxiliary functions
   //@{
@@ -218,6 +299,8 @@ public:
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return m_computedValues; }
+  /// Returns an array-based snapshot of the tree, building it if needed
+  const FlatGameTree &GetFlatTree(void) const;
   //@}
 
   /// @name Writing data files
@@ -48,15 +48,74 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  /// Computes the value of each strategy in the support to its player,
+  /// indexed as the profile is
+  virtual void GetStrategyValues(Vector<T> &p_values) const;
 };
 
+/// \brief A mixed strategy profile on a game tree
+///
+/// Payoffs are computed from the sequence form of the profile: the
+/// total probability each player puts on the strategies consistent
+/// with each of his sequences of actions, and for each sequence, the
+/// payoff contributions of the nodes it is the last sequence of its
+/// player on the path to.  These, and the sequences each strategy is
+/// consistent with, are computed in one pass over the tree, and are
+/// kept until the probabilities change.  This requires perfect recall;
+/// otherwise, each payoff is computed from the behavior profile to
+/// which the profile converts.
 template <class T> class TreeMixedStrategyProfileRep 
   : public MixedStrategyProfileRep<T> {
+private:
+  /// @name Cached data
+  //@{
+  /// Whether the game has perfect recall
+  mutable bool m_perfectRecall;
+  /// The sequences each strategy in the support is consistent with,
+  /// given by the slots of their last actions
+  mutable Array<Array<int> > m_strategySlots;
+  /// The slot of the last action of each player on the path to each
+  /// node (0 if none), indexed by player and then node
+  mutable Array<Array<int> > m_nodeSlots;
+  /// The probabilities for which the remaining data were computed
+  mutable Array<T> m_cacheProbs;
+  /// The product of chance probabilities on the path to each node
+  mutable Array<T> m_chanceProbs;
+  /// The realization probability of each player's part of the path
+  /// to each node, indexed by player and then node
+  mutable Array<Array<T> > m_nodeProbs;
+  /// Payoffs to each player
+  mutable Array<T> m_payoffs;
+  /// Contributions to each player's payoff of the nodes to which each
+  /// sequence is the last of its player, with that player's part of
+  /// the path taken as certain.  The sequences are indexed by the slot
+  /// of their last action in m_seqValues (by player paid, then slot),
+  /// and the empty sequences by player in m_rootValues (by player, then
+  /// player paid).
+  mutable Array<Array<T> > m_seqValues, m_rootValues;
+  //@}
+
+  /// @name Private auxiliary functions
+  //@{
+  /// Computes the sequences which each strategy is consistent with
+  void ComputeSequences(void) const;
+  /// \brief Brings the cached data up to date with the probabilities
+  ///
+  /// Brings the cached data up to date with the probabilities.  Returns
+  /// false if the game does not have perfect recall, in which case
+  /// there are none.
+  bool ComputePayoffs(void) const;
+  //@}
+
 public:
   TreeMixedStrategyProfileRep(const StrategySupport &p_support)
     : MixedStrategyProfileRep<T>(p_support)
   { }
   TreeMixedStrategyProfileRep(const MixedBehavProfile<T> &);
+  /// Copies the probabilities, but not the cached data
+  TreeMixedStrategyProfileRep(const TreeMixedStrategyProfileRep<T> &p_profile)
+    : MixedStrategyProfileRep<T>(p_profile)
+  { }
   virtual ~TreeMixedStrategyProfileRep() { }
   
   virtual MixedStrategyProfileRep<T> *Copy(void) const;
@@ -78,6 +137,10 @@ private:
   /// Recursive computation of payoff second derivative
   void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
 		      int cur_pl, long index, const T &prob, T &value) const;
+  /// Payoff computation over a sparsely-stored table, with the
+  /// strategies of up to two players (if non-null) held fixed
+  T GetSparsePayoff(int pl, GameStrategyRep *p_fixed1,
+		    GameStrategyRep *p_fixed2) const;
   //@}
 
 public:
@@ -213,6 +276,14 @@ public:
   T GetStrategyValue(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to playing each pure strategy
+  ///
+  /// Computes the value of each strategy in the support against the
+  /// profile, indexed as the profile is.  For games in extensive form,
+  /// this is done in one pass over the tree.
+  void GetStrategyValues(Vector<T> &p_values) const
+  { m_rep->GetStrategyValues(p_values); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
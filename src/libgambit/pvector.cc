@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
+
 #include "libgambit.h"
 #include "pvector.imp"
 
@@ -27,3 +29,13 @@ template class Gambit::PVector<int>;
 template class Gambit::PVector<double>;
 template class Gambit::PVector<Gambit::Rational>;
 
+
+double Gambit::RowLogSumExp(const Gambit::PVector<double> &v, int row)
+{
+  double max = v.RowMax(row);
+  const double *x = v.svptr[row];
+  double sum = 0.0;
+  for (int i = 1; i <= v.svlen[row]; i++)
+    sum += std::exp(x[i] - max);
+  return max + std::log(sum);
+}
@@ -27,7 +27,13 @@
 
 namespace Gambit {
 
+template <class T> class PVector;
+/// Computes log(sum(exp(v(row, i)))) over a subvector, scaled by the
+/// subvector's maximum so that large entries do not overflow
+double RowLogSumExp(const PVector<double> &v, int row);
+
 template <class T> class PVector : public Vector<T> {
+  friend double RowLogSumExp(const PVector<double> &, int);
  private:
   int sum(const Array<int> &V) const;
   void setindex(void);
@@ -78,6 +84,12 @@ template <class T> class PVector : public Vector<T> {
   bool operator==(const PVector<T> &v) const;
   bool operator!=(const PVector<T> &v) const;
 
+  // operations on a single subvector, working directly on its storage
+  T RowSum(int row) const;
+  T RowMax(int row) const;
+  void NormalizeRow(int row);
+  void NormalizeRows(void);
+
   // parameter access functions
   const Array<int>& Lengths(void) const;
 };
@@ -74,6 +74,7 @@ public:
 class StrategySupport {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class MixedStrategyProfileRep;
+  template <class T> friend class TreeMixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
 protected:
   Game m_nfg;
@@ -24,6 +24,7 @@
 #include "subgame.h"
 
 #include <stdlib.h>
+#include <map>
 
 namespace Gambit {
 
@@ -59,6 +60,26 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
   }
 }
 
+///
+/// Returns a key identifying the structure and payoffs of 'p_game'.
+/// Information set labels are cleared first, since these carry the
+/// unique IDs used to map back into the original game; two subgames
+/// with equal keys therefore have the same set of equilibria, indexed
+/// in the same way.
+///
+std::string SubgameKey(const Game &p_game)
+{
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      player->GetInfoset(iset)->SetLabel("");
+    }
+  }
+  std::ostringstream os;
+  p_game->WriteEfgFile(os);
+  return os.str();
+}
+
 } // end nested anonymous namespace
 
 
@@ -77,6 +98,11 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
 //   quantities are irrelevant for this calculation, so we only
 //   store the probabilities, and convert to MixedBehavProfiles
 //   at the end of the computation
+// * Solutions of each subgame solved are memoised, keyed on the
+//   text of the subgame file with the information set IDs removed.
+//   Subgames which recur -- either as structurally identical siblings,
+//   or in several scenarios of child subgame values -- are then only
+//   passed to the solver once.
 //
 
 template <class T, class SolverType>
@@ -85,7 +111,8 @@ void SolveSubgames(const BehavSupport &p_support,
 		   SolverType p_solver,
 		   GameNode n,
 		   List<DVector<T> > &solns,
-		   List<GameOutcome> &values)
+		   List<GameOutcome> &values,
+		   std::map<std::string, List<MixedBehavProfile<T> > > &p_cache)
 {
   Game efg = p_support.GetGame();
   
@@ -107,7 +134,7 @@ void SolveSubgames(const BehavSupport &p_support,
     List<GameOutcome> subvalues;
     
     SolveSubgames(p_support, p_templateSolution, p_solver,
-		  subroots[i], subsolns, subvalues);
+		  subroots[i], subsolns, subvalues, p_cache);
     
     if (subsolns.Length() == 0)  {
       solns = List<DVector<T> >();
@@ -124,12 +151,8 @@ void SolveSubgames(const BehavSupport &p_support,
     for (int soln = 1; soln <= thissolns.Length(); soln++) {
       for (int subsoln = 1; subsoln <= subsolns.Length(); subsoln++) {
 	//printf("Merging existing %d with new %d\n", soln, subsoln);
-	DVector<T> bp(thissolns[soln]);
-	DVector<T> tmp(subsolns[subsoln]);
-	for (int j = 1; j <= bp.Length(); j++) {
-	  bp[j] += tmp[j];
-	}
-	newsolns.Append(bp);
+	newsolns.Append(thissolns[soln]);
+	newsolns[newsolns.Length()] += subsolns[subsoln];
 	
 	newsubrootvalues.Append(subrootvalues[soln]);
 	newsubrootvalues[newsubrootvalues.Length()][i] = subvalues[subsoln];
@@ -177,7 +200,22 @@ void SolveSubgames(const BehavSupport &p_support,
     }
     */
 
-    List<MixedBehavProfile<T> > sol = (*p_solver)(subsupport);
+    // The IDs of the subgame's information sets in the original game;
+    // these are recorded before computing the key, which clears them.
+    PVector<int> ids(subgame->NumInfosets());
+    for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
+      GamePlayer subplayer = subgame->GetPlayer(pl);
+      for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
+	ids(pl, iset) = atoi(subplayer->GetInfoset(iset)->GetLabel().c_str());
+      }
+    }
+
+    std::string key = SubgameKey(subgame);
+    typename std::map<std::string, List<MixedBehavProfile<T> > >::const_iterator cached = p_cache.find(key);
+    if (cached == p_cache.end()) {
+      cached = p_cache.insert(std::make_pair(key, (*p_solver)(subsupport))).first;
+    }
+    const List<MixedBehavProfile<T> > &sol = cached->second;
     
     if (sol.Length() == 0)  {
       solns = List<DVector<T> >();
@@ -191,20 +229,10 @@ void SolveSubgames(const BehavSupport &p_support,
       
       for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
 	GamePlayer subplayer = subgame->GetPlayer(pl);
-	GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
 	for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	  GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	  for (int j = 1; j <= player->NumInfosets(); j++) {
-	    if (subinfoset->GetLabel() == player->GetInfoset(j)->GetLabel()) {
-	      int id = atoi(subinfoset->GetLabel().c_str());
-	      for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
-		int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
-		solns[solns.Length()](pl, id, actno) = sol[solno](pl, iset, act);	  
-	      }
-	      break;
-	    }
+	  for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
+	    int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
+	    solns[solns.Length()](pl, ids(pl, iset), actno) = sol[solno](pl, iset, act);
 	  }
 	}
       }
@@ -261,8 +289,9 @@ SolveBySubgames(const BehavSupport &p_support,
 
   List<DVector<T> > vectors;
   List<GameOutcome> values;
+  std::map<std::string, List<MixedBehavProfile<T> > > cache;
   SolveSubgames(support, DVector<T>(support.NumActions()),
-		p_solver, efg->GetRoot(), vectors, values);
+		p_solver, efg->GetRoot(), vectors, values, cache);
 
   List<MixedBehavProfile<T> > solutions;
   for (int i = 1; i <= vectors.Length(); i++) {
@@ -67,6 +67,13 @@ public:
   
   // square of length
   T NormSquared() const;
+
+  /** Adds a times V to the vector (the BLAS 'axpy' operation) */
+  Vector<T> &Axpy(T a, const Vector<T> &V);
+  /** Sets the vector to U plus a times V */
+  Vector<T> &SetAxpy(const Vector<T> &U, T a, const Vector<T> &V);
+  /** Returns the sum of the components of the vector */
+  T Sum(void) const;
   
   // check vector for identical boundaries
   bool Check(const Vector<T> &v) const;
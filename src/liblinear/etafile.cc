@@ -0,0 +1,123 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/etafile.cc
+// Product-form representation of the inverse of a sparse basis
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include "etafile.h"
+
+EtaFile::EtaFile(int p_size)
+  : m_size(p_size)
+{
+  m_start.push_back(0);
+}
+
+void EtaFile::Clear(void)
+{
+  m_row.clear();
+  m_pivot.clear();
+  m_start.clear();
+  m_start.push_back(0);
+  m_index.clear();
+  m_value.clear();
+}
+
+void EtaFile::Append(int p_row, const Gambit::Vector<double> &p_column)
+{
+  if (p_column[p_row] == 0.0) {
+    throw BadPivot();
+  }
+  const double *column = &p_column[1] - 1;
+  for (int i = 1; i <= m_size; i++) {
+    if (i != p_row && column[i] != 0.0) {
+      m_index.push_back(i);
+      m_value.push_back(column[i]);
+    }
+  }
+  m_row.push_back(p_row);
+  m_pivot.push_back(column[p_row]);
+  m_start.push_back(m_index.size());
+}
+
+void EtaFile::Append(int p_row, const Gambit::Vector<double> &p_column,
+		     const std::vector<int> &p_pattern)
+{
+  if (p_column[p_row] == 0.0) {
+    throw BadPivot();
+  }
+  const double *column = &p_column[1] - 1;
+  for (size_t k = 0; k < p_pattern.size(); k++) {
+    int i = p_pattern[k];
+    if (i != p_row && column[i] != 0.0) {
+      m_index.push_back(i);
+      m_value.push_back(column[i]);
+    }
+  }
+  m_row.push_back(p_row);
+  m_pivot.push_back(column[p_row]);
+  m_start.push_back(m_index.size());
+}
+
+void EtaFile::Solve(Gambit::Vector<double> &x) const
+{
+  double *v = &x[1] - 1;
+  for (int k = 0; k < NumEtas(); k++) {
+    double &xr = v[m_row[k]];
+    if (xr == 0.0) {
+      continue;
+    }
+    xr /= m_pivot[k];
+    for (int j = m_start[k]; j < m_start[k+1]; j++) {
+      v[m_index[j]] -= m_value[j] * xr;
+    }
+  }
+}
+
+void EtaFile::Solve(Gambit::Vector<double> &x, std::vector<int> &p_pattern,
+		    std::vector<char> &p_mark) const
+{
+  double *v = &x[1] - 1;
+  for (int k = 0; k < NumEtas(); k++) {
+    double &xr = v[m_row[k]];
+    if (xr == 0.0) {
+      continue;
+    }
+    xr /= m_pivot[k];
+    for (int j = m_start[k]; j < m_start[k+1]; j++) {
+      int i = m_index[j];
+      if (!p_mark[i]) {
+	p_mark[i] = 1;
+	p_pattern.push_back(i);
+      }
+      v[i] -= m_value[j] * xr;
+    }
+  }
+}
+
+void EtaFile::SolveT(Gambit::Vector<double> &y) const
+{
+  double *v = &y[1] - 1;
+  for (int k = NumEtas() - 1; k >= 0; k--) {
+    double yr = v[m_row[k]];
+    for (int j = m_start[k]; j < m_start[k+1]; j++) {
+      yr -= m_value[j] * v[m_index[j]];
+    }
+    v[m_row[k]] = yr / m_pivot[k];
+  }
+}
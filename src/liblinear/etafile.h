@@ -0,0 +1,90 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/etafile.h
+// Product-form representation of the inverse of a sparse basis
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef ETAFILE_H
+#define ETAFILE_H
+
+#include <vector>
+#include "libgambit/libgambit.h"
+
+/// A sparse column, as a list of (row, value) pairs
+typedef std::vector<std::pair<int, double> > SparseColumn;
+
+//
+// An EtaFile represents the inverse of a basis B as a product
+// E_k^{-1} ... E_1^{-1} of elementary column transformations.  Each
+// transformation is stored as the nonzero entries of the column it
+// pivots in, so that both the storage and the cost of a solve are
+// proportional to the number of nonzeros rather than to the square of
+// the dimension.  Rows are indexed from 1.
+//
+class EtaFile {
+public:
+  class BadPivot : public Gambit::Exception  {
+  public:
+    virtual ~BadPivot() throw() { }
+    const char *what(void) const throw() { return "Bad pivot in EtaFile"; }
+  };
+
+  /// Construct the representation of the identity of the given dimension
+  EtaFile(int p_size);
+
+  /// The dimension of the basis
+  int Size(void) const { return m_size; }
+  /// The number of transformations in the file
+  int NumEtas(void) const { return m_row.size(); }
+  /// The total number of off-pivot nonzeros stored
+  int NumNonzeros(void) const { return m_index.size(); }
+
+  /// Reset to the identity
+  void Clear(void);
+
+  /// Record the replacement of the basis column in row p_row by a column
+  /// whose representation in the current basis is p_column
+  void Append(int p_row, const Gambit::Vector<double> &p_column);
+  /// As above, for a column which is zero outside p_pattern
+  void Append(int p_row, const Gambit::Vector<double> &p_column,
+	      const std::vector<int> &p_pattern);
+
+  /// Solve B x = a; x holds a on entry
+  void Solve(Gambit::Vector<double> &x) const;
+
+  /// Solve y B = c; y holds c on entry
+  void SolveT(Gambit::Vector<double> &y) const;
+
+  /// Solve B x = a, for a sparse in a work vector x which is zero outside
+  /// p_pattern.  On exit, p_pattern lists (a superset of) the nonzero
+  /// entries of x; p_mark flags the members of p_pattern.
+  void Solve(Gambit::Vector<double> &x, std::vector<int> &p_pattern,
+	     std::vector<char> &p_mark) const;
+
+private:
+  int m_size;
+  // For each transformation, its pivot row and pivot value, and the
+  // location of its off-pivot entries in m_index/m_value
+  std::vector<int> m_row, m_start;
+  std::vector<double> m_pivot;
+  std::vector<int> m_index;
+  std::vector<double> m_value;
+};
+
+#endif  // ETAFILE_H
@@ -0,0 +1,636 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparselp.cc
+// Implementation of revised simplex LP solver on sparse columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <math.h>
+#include <algorithm>
+#include "sparselp.h"
+
+namespace {
+
+// Refactor after this many pivots since the last refactorization...
+const int c_maxEtas = 100;
+// ...or once the pivots have added this multiple of the nonzeros of
+// the fresh factorization
+const int c_maxFill = 2;
+
+// Tolerances on reduced costs, pivot elements, and bound violations
+const double c_optTol = 1.0e-9;
+const double c_pivotTol = 1.0e-7;
+const double c_feasTol = 1.0e-9;
+// Phase I is deemed to have failed if the artificials sum to more than this
+const double c_infeasTol = 1.0e-6;
+
+// Relative size of the perturbation of the right-hand side
+const double c_perturbation = 1.0e-6;
+
+//
+// The problem is solved with b perturbed by small positive amounts,
+// which makes ties in the ratio test, and hence stalling and cycling
+// at degenerate vertices, unlikely.  For small enough perturbations, a
+// basis optimal for the perturbed problem is optimal for the original
+// one.  A fixed generator is used so that results are reproducible.
+//
+Gambit::Vector<double> Perturb(const Gambit::Vector<double> &b)
+{
+  Gambit::Vector<double> ret(b);
+  unsigned long seed = 1;
+  for (int i = 1; i <= b.Length(); i++) {
+    seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    ret[i] += c_perturbation * (1.0 + fabs(b[i])) * (1.0 + seed / 2147483648.0);
+  }
+  return ret;
+}
+
+//
+// A row whose slack cannot start at b_i gets an artificial variable,
+// with column +/- e_i so that it starts at |b_i|
+//
+bool NeedsArtificial(const Gambit::Vector<double> &b, int nequals, int i)
+{
+  return (i <= b.Length() - nequals) ? (b[i] < 0.0) : (b[i] != 0.0);
+}
+
+int NumArtificials(const Gambit::Vector<double> &b, int nequals)
+{
+  int count = 0;
+  for (int i = 1; i <= b.Length(); i++) {
+    if (NeedsArtificial(b, nequals, i)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+class ColumnLengthLess {
+private:
+  const std::vector<int> &m_start;
+public:
+  ColumnLengthLess(const std::vector<int> &p_start) : m_start(p_start) { }
+  bool operator()(int p_a, int p_b) const
+  { return m_start[p_a] - m_start[p_a-1] < m_start[p_b] - m_start[p_b-1]; }
+};
+
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------
+//                  Sparse LP solver: construction and phases
+//---------------------------------------------------------------------------
+
+SparseLPSolve::SparseLPSolve(const Gambit::Matrix<double> &A,
+			     const Gambit::Vector<double> &b,
+			     const Gambit::Vector<double> &c, int nequals,
+			     const Gambit::Array<int> &p_basis,
+			     bool p_steepestEdge)
+  : m_numRows(b.Length()), m_b(Perturb(b)),
+    m_numVars(c.Length() + b.Length() + NumArtificials(m_b, nequals)),
+    m_fixed(m_numVars), m_cost(m_numVars),
+    m_reducedCost(m_numVars), m_weight(m_numVars),
+    m_steepestEdge(p_steepestEdge),
+    m_head(b.Length()), m_row(m_numVars), m_eta(b.Length()),
+    m_refactorEtas(0), m_refactorNonzeros(0), m_x(b.Length()),
+    m_feasible(true), m_bounded(true), m_numPivots(0),
+    m_primal(c.Length()), m_dual(b.Length())
+{
+  int n = c.Length(), m = m_numRows;
+
+  m_start.push_back(0);
+  for (int j = 1; j <= n; j++) {
+    for (int i = 1; i <= m; i++) {
+      if (A(i, j) != 0.0) {
+	m_index.push_back(i);
+	m_value.push_back(A(i, j));
+      }
+    }
+    m_start.push_back(m_index.size());
+  }
+  for (int i = 1; i <= m; i++) {
+    m_index.push_back(i);
+    m_value.push_back(1.0);
+    m_start.push_back(m_index.size());
+  }
+  for (int i = 1; i <= m; i++) {
+    if (NeedsArtificial(m_b, nequals, i)) {
+      m_index.push_back(i);
+      m_value.push_back((m_b[i] < 0.0) ? -1.0 : 1.0);
+      m_start.push_back(m_index.size());
+    }
+  }
+
+  if (p_basis.Length() == 0 || !WarmStart(p_basis, c, nequals)) {
+    if (!PhaseOne(nequals)) {
+      m_feasible = false;
+      return;
+    }
+  }
+
+  // Phase II
+  m_cost = 0.0;
+  for (int j = 1; j <= n; j++) {
+    m_cost[j] = c[j];
+  }
+  m_bounded = Solve();
+
+  // Take away the perturbation; the optimal basis may then be slightly
+  // infeasible for the original right-hand side
+  m_b = b;
+  Refactor();
+  if (m_bounded) {
+    RestoreFeasibility();
+  }
+
+  m_primal = 0.0;
+  for (int i = 1; i <= m; i++) {
+    if (m_head[i] <= n) {
+      m_primal[m_head[i]] = (m_x[i] > 0.0) ? m_x[i] : 0.0;
+    }
+  }
+  for (int i = 1; i <= m; i++) {
+    m_dual[i] = m_cost[m_head[i]];
+  }
+  m_eta.SolveT(m_dual);
+  for (int i = 1; i <= m - nequals; i++) {
+    m_dual[i] = (m_dual[i] > 0.0) ? m_dual[i] : 0.0;
+  }
+}
+
+double SparseLPSolve::OptimumCost(void) const
+{
+  double total = 0.0;
+  for (int j = 1; j <= m_primal.Length(); j++) {
+    total += m_cost[j] * m_primal[j];
+  }
+  return total;
+}
+
+Gambit::Array<int> SparseLPSolve::GetBasis(void) const
+{
+  int n = m_primal.Length();
+  Gambit::Array<int> basis(m_numRows);
+  for (int i = 1; i <= m_numRows; i++) {
+    if (m_head[i] <= n) {
+      basis[i] = m_head[i];
+    }
+    else {
+      // Slacks are labeled by their rows; an artificial left in the
+      // basis is at zero, and stands in for the slack of its row
+      basis[i] = -m_index[m_start[m_head[i]-1]];
+    }
+  }
+  return basis;
+}
+
+//
+// Starts from the basis of slacks, with artificials in the rows whose
+// slacks would be infeasible, and drives the artificials to zero.
+// Returns false if this fails, that is, if the problem is infeasible.
+//
+bool SparseLPSolve::PhaseOne(int nequals)
+{
+  int n = m_primal.Length(), m = m_numRows;
+
+  for (int j = 1; j <= m_numVars; j++) {
+    m_fixed[j] = (j > n && j <= n+m && j - n > m - nequals);
+    m_row[j] = 0;
+  }
+  for (int i = 1, j = n+m+1; i <= m; i++) {
+    m_head[i] = (NeedsArtificial(m_b, nequals, i)) ? j++ : n+i;
+    m_row[m_head[i]] = i;
+  }
+
+  // The initial basis is diagonal, so the steepest edge weights
+  // 1 + |B^{-1} a_j|^2 can be set exactly
+  for (int j = 1; j <= m_numVars; j++) {
+    m_weight[j] = 1.0;
+    for (int k = m_start[j-1]; k < m_start[j]; k++) {
+      m_weight[j] += m_value[k] * m_value[k];
+    }
+  }
+
+  // Maximize the negative of the sum of the artificials
+  m_cost = 0.0;
+  for (int j = n+m+1; j <= m_numVars; j++) {
+    m_cost[j] = -1.0;
+  }
+  Refactor();
+  if (m_numVars > n+m) {
+    Solve();
+    double infeas = 0.0;
+    for (int i = 1; i <= m; i++) {
+      if (m_head[i] > n+m) {
+	infeas += m_x[i];
+      }
+    }
+    if (infeas > c_infeasTol) {
+      return false;
+    }
+    // Artificials still in the basis are held at zero from now on
+    for (int j = n+m+1; j <= m_numVars; j++) {
+      m_fixed[j] = true;
+    }
+  }
+  return true;
+}
+
+//
+// Starts from the given basis, which is typically optimal for a closely
+// related problem.  If it is not primal feasible, feasibility is
+// restored by the dual simplex method, during which the variables
+// whose reduced costs would make the basis dual infeasible are held at
+// zero.  Returns false, leaving the caller to start afresh, if the
+// basis is singular or feasibility cannot be restored in this way.
+//
+bool SparseLPSolve::WarmStart(const Gambit::Array<int> &p_basis,
+			      const Gambit::Vector<double> &c, int nequals)
+{
+  int n = c.Length(), m = m_numRows;
+
+  for (int j = 1; j <= m_numVars; j++) {
+    m_fixed[j] = (j > n+m || (j > n && j - n > m - nequals));
+    m_row[j] = 0;
+    // The weights are reset to those of the reference framework
+    m_weight[j] = 1.0;
+  }
+  for (int i = 1; i <= m; i++) {
+    m_head[i] = (p_basis[i] > 0) ? p_basis[i] : n - p_basis[i];
+    if (m_row[m_head[i]] != 0) {
+      return false;
+    }
+    m_row[m_head[i]] = i;
+  }
+  try {
+    Refactor();
+  }
+  catch (EtaFile::BadPivot &) {
+    return false;
+  }
+
+  m_cost = 0.0;
+  for (int j = 1; j <= n; j++) {
+    m_cost[j] = c[j];
+  }
+  ComputeReducedCosts();
+  std::vector<int> held;
+  for (int j = 1; j <= m_numVars; j++) {
+    if (m_row[j] == 0 && !m_fixed[j] && m_reducedCost[j] > c_optTol) {
+      m_fixed[j] = true;
+      held.push_back(j);
+    }
+  }
+  bool feasible = RestoreFeasibility();
+  for (size_t k = 0; k < held.size(); k++) {
+    m_fixed[held[k]] = false;
+  }
+  return feasible;
+}
+
+//---------------------------------------------------------------------------
+//                    Sparse LP solver: simplex iterations
+//---------------------------------------------------------------------------
+
+double SparseLPSolve::Dot(const Gambit::Vector<double> &p_v, int p_var) const
+{
+  const double *v = &p_v[1] - 1;
+  double total = 0.0;
+  for (int k = m_start[p_var-1]; k < m_start[p_var]; k++) {
+    total += v[m_index[k]] * m_value[k];
+  }
+  return total;
+}
+
+void SparseLPSolve::Dot(const Gambit::Vector<double> &p_u,
+			const Gambit::Vector<double> &p_v, int p_var,
+			double &p_uDot, double &p_vDot) const
+{
+  const double *u = &p_u[1] - 1, *v = &p_v[1] - 1;
+  p_uDot = p_vDot = 0.0;
+  for (int k = m_start[p_var-1]; k < m_start[p_var]; k++) {
+    p_uDot += u[m_index[k]] * m_value[k];
+    p_vDot += v[m_index[k]] * m_value[k];
+  }
+}
+
+void SparseLPSolve::ComputeReducedCosts(void)
+{
+  Gambit::Vector<double> y(m_numRows);
+  for (int i = 1; i <= m_numRows; i++) {
+    y[i] = m_cost[m_head[i]];
+  }
+  m_eta.SolveT(y);
+  for (int j = 1; j <= m_numVars; j++) {
+    m_reducedCost[j] = (m_row[j] != 0) ? 0.0 : m_cost[j] - Dot(y, j);
+  }
+}
+
+//
+// Runs the simplex method from the current basis under the current
+// costs.  Returns false if the problem is found to be unbounded.
+// Optimality is only accepted once it is confirmed by reduced costs
+// computed afresh, rather than by the updated ones.
+//
+bool SparseLPSolve::Solve(void)
+{
+  Gambit::Vector<double> alpha(m_numRows);
+  ComputeReducedCosts();
+  while (true) {
+    int in = Enter();
+    if (in == 0) {
+      ComputeReducedCosts();
+      if ((in = Enter()) == 0) {
+	return true;
+      }
+    }
+
+    alpha = 0.0;
+    for (int k = m_start[in-1]; k < m_start[in]; k++) {
+      alpha[m_index[k]] = m_value[k];
+    }
+    m_eta.Solve(alpha);
+
+    int out = Exit(alpha, in);
+    if (out == 0) {
+      return false;
+    }
+    Pivot(out, in, alpha);
+  }
+}
+
+//
+// Chooses the entering variable: the one maximizing d_j^2 / w_j under
+// steepest edge pricing, or d_j otherwise.
+//
+int SparseLPSolve::Enter(void) const
+{
+  int in = 0;
+  double best = 0.0;
+  for (int j = 1; j <= m_numVars; j++) {
+    double d = m_reducedCost[j];
+    if (m_row[j] != 0 || m_fixed[j] || d <= c_optTol) {
+      continue;
+    }
+    double score = (m_steepestEdge) ? d * d / m_weight[j] : d;
+    if (score > best) {
+      best = score;
+      in = j;
+    }
+  }
+  return in;
+}
+
+//
+// Chooses the leaving row by Harris' two-pass ratio test: the first pass
+// finds the largest step which violates no bound by more than the
+// tolerance, and the second picks, among the rows which block at or
+// before that step, the one with the largest pivot element.  Returns
+// zero if no row blocks.
+//
+int SparseLPSolve::Exit(const Gambit::Vector<double> &p_alpha, int p_in) const
+{
+  double tmax = 0.0;
+  bool blocked = false;
+  for (int i = 1; i <= m_numRows; i++) {
+    double a = p_alpha[i], t;
+    if (a > c_pivotTol) {
+      t = (m_x[i] + c_feasTol) / a;
+    }
+    else if (a < -c_pivotTol && m_fixed[m_head[i]]) {
+      t = (m_x[i] - c_feasTol) / a;
+    }
+    else {
+      continue;
+    }
+    if (!blocked || t < tmax) {
+      tmax = t;
+      blocked = true;
+    }
+  }
+  if (!blocked) {
+    return 0;
+  }
+
+  int out = 0;
+  for (int i = 1; i <= m_numRows; i++) {
+    double a = p_alpha[i];
+    if ((a > c_pivotTol || (a < -c_pivotTol && m_fixed[m_head[i]])) &&
+	m_x[i] / a <= tmax && (out == 0 || fabs(a) > fabs(p_alpha[out]))) {
+      out = i;
+    }
+  }
+  return out;
+}
+
+//
+// Runs dual simplex pivots until the basic variables are within their
+// bounds.  The basis is dual feasible on entry and remains so; the row
+// which most violates its bound leaves, and the entering variable is
+// chosen by the ratio test on the reduced costs.  The number of pivots
+// is bounded to guard against cycling.  Returns false if the bounds
+// cannot be met.
+//
+bool SparseLPSolve::RestoreFeasibility(void)
+{
+  Gambit::Vector<double> rho(m_numRows), alpha(m_numRows);
+  for (int iter = 1; iter <= m_numRows + m_numVars; iter++) {
+    int out = 0;
+    double worst = c_feasTol;
+    for (int i = 1; i <= m_numRows; i++) {
+      double v = (m_fixed[m_head[i]]) ? fabs(m_x[i]) : -m_x[i];
+      if (v > worst) {
+	worst = v;
+	out = i;
+      }
+    }
+    if (out == 0) {
+      return true;
+    }
+
+    // The basic variable must rise if it is negative, and fall otherwise
+    double sign = (m_x[out] < 0.0) ? -1.0 : 1.0;
+    rho = 0.0;
+    rho[out] = 1.0;
+    m_eta.SolveT(rho);
+    int in = 0;
+    double best = 0.0, bestAlpha = 0.0;
+    for (int j = 1; j <= m_numVars; j++) {
+      if (m_row[j] != 0 || m_fixed[j]) {
+	continue;
+      }
+      double a = sign * Dot(rho, j);
+      if (a <= c_pivotTol) {
+	continue;
+      }
+      double ratio = std::max(-m_reducedCost[j], 0.0) / a;
+      if (in == 0 || ratio < best || (ratio == best && a > bestAlpha)) {
+	in = j;
+	best = ratio;
+	bestAlpha = a;
+      }
+    }
+    if (in == 0) {
+      return false;
+    }
+
+    alpha = 0.0;
+    for (int k = m_start[in-1]; k < m_start[in]; k++) {
+      alpha[m_index[k]] = m_value[k];
+    }
+    m_eta.Solve(alpha);
+    Pivot(out, in, alpha);
+  }
+  return false;
+}
+
+void SparseLPSolve::Pivot(int p_row, int p_in,
+			  const Gambit::Vector<double> &p_alpha)
+{
+  int out = m_head[p_row];
+  double pivot = p_alpha[p_row];
+
+  double step = std::max(m_x[p_row] / pivot, 0.0);
+  for (int i = 1; i <= m_numRows; i++) {
+    m_x[i] -= step * p_alpha[i];
+  }
+  m_x[p_row] = step;
+
+  // Update the reduced costs, and the steepest edge weights, of the
+  // nonbasic variables from the pivot row e_r B^{-1} A of the old basis
+  Gambit::Vector<double> rho(m_numRows), tau(m_numRows);
+  rho = 0.0;
+  rho[p_row] = 1.0;
+  m_eta.SolveT(rho);
+  double weight = 1.0;
+  if (m_steepestEdge) {
+    tau = p_alpha;
+    m_eta.SolveT(tau);
+    weight += p_alpha * p_alpha;
+  }
+  double dq = m_reducedCost[p_in];
+  for (int j = 1; j <= m_numVars; j++) {
+    if (m_row[j] != 0 || m_fixed[j] || j == p_in) {
+      continue;
+    }
+    double ratio, tauDot = 0.0;
+    if (m_steepestEdge) {
+      Dot(rho, tau, j, ratio, tauDot);
+    }
+    else {
+      ratio = Dot(rho, j);
+    }
+    if (ratio == 0.0) {
+      continue;
+    }
+    ratio /= pivot;
+    m_reducedCost[j] -= ratio * dq;
+    if (m_steepestEdge) {
+      m_weight[j] = std::max(m_weight[j] - 2.0 * ratio * tauDot +
+			     ratio * ratio * weight,
+			     1.0 + ratio * ratio);
+    }
+  }
+  m_reducedCost[p_in] = 0.0;
+  m_reducedCost[out] = -dq / pivot;
+  if (m_steepestEdge) {
+    m_weight[out] = std::max(weight / (pivot * pivot), 1.0);
+  }
+
+  m_eta.Append(p_row, p_alpha);
+  m_row[out] = 0;
+  m_head[p_row] = p_in;
+  m_row[p_in] = p_row;
+  // An artificial variable which leaves the basis never needs to return
+  if (out > m_primal.Length() + m_numRows) {
+    m_fixed[out] = true;
+  }
+  m_numPivots++;
+
+  if (m_eta.NumEtas() - m_refactorEtas >= c_maxEtas ||
+      (m_eta.NumNonzeros() - m_refactorNonzeros >
+       c_maxFill * m_refactorNonzeros + m_numRows)) {
+    Refactor();
+    ComputeReducedCosts();
+  }
+}
+
+//
+// Refactorization proceeds as in SparseLTableau: the basic columns are
+// pivoted into the identity in order of increasing number of nonzeros,
+// each into the row with the largest entry among those not yet taken.
+// Unit columns pivoted into their own row need no transformation.
+//
+void SparseLPSolve::Refactor(void)
+{
+  int m = m_numRows;
+  std::vector<int> columns;
+  for (int i = 1; i <= m; i++) {
+    columns.push_back(m_head[i]);
+    m_row[m_head[i]] = 0;
+  }
+  std::stable_sort(columns.begin(), columns.end(),
+		   ColumnLengthLess(m_start));
+
+  m_eta.Clear();
+  Gambit::Array<bool> available(m);
+  for (int i = 1; i <= m; i++) {
+    available[i] = true;
+  }
+
+  Gambit::Vector<double> work(m);
+  work = 0.0;
+  std::vector<int> pattern;
+  std::vector<char> mark(m + 1, 0);
+  for (size_t c = 0; c < columns.size(); c++) {
+    pattern.clear();
+    for (int k = m_start[columns[c]-1]; k < m_start[columns[c]]; k++) {
+      work[m_index[k]] = m_value[k];
+      mark[m_index[k]] = 1;
+      pattern.push_back(m_index[k]);
+    }
+    m_eta.Solve(work, pattern, mark);
+
+    int pivot = 0;
+    for (size_t k = 0; k < pattern.size(); k++) {
+      int i = pattern[k];
+      if (available[i] &&
+	  (pivot == 0 || fabs(work[i]) > fabs(work[pivot]))) {
+	pivot = i;
+      }
+    }
+    if (pivot == 0 || fabs(work[pivot]) <= c_pivotTol) {
+      throw EtaFile::BadPivot();
+    }
+    if (pattern.size() > 1 || work[pivot] != 1.0) {
+      m_eta.Append(pivot, work, pattern);
+    }
+    available[pivot] = false;
+    m_head[pivot] = columns[c];
+    m_row[columns[c]] = pivot;
+
+    for (size_t k = 0; k < pattern.size(); k++) {
+      work[pattern[k]] = 0.0;
+      mark[pattern[k]] = 0;
+    }
+  }
+
+  m_refactorEtas = m_eta.NumEtas();
+  m_refactorNonzeros = m_eta.NumNonzeros();
+  m_x = m_b;
+  m_eta.Solve(m_x);
+}
@@ -0,0 +1,115 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparselp.h
+// Revised simplex LP solver on sparse columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSELP_H
+#define SPARSELP_H
+
+#include <vector>
+#include "libgambit/libgambit.h"
+#include "liblinear/etafile.h"
+
+//
+// This class solves the same problems as LPSolve: maximize c x subject
+// to A x <= b, x >= 0, where the last 'nequals' rows of A hold with
+// equality.  It uses the revised simplex method, keeping A by sparse
+// columns and the inverse of the basis as an EtaFile, which is
+// refactored once the updates have grown it beyond a multiple of the
+// size of the fresh factorization.  The reduced costs are updated from
+// the pivot row rather than recomputed at each pivot.  Degenerate
+// vertices are handled by perturbing b.
+//
+// Entering variables are chosen by the steepest edge rule, with the
+// reference weights updated exactly (Goldfarb and Reid), or optionally
+// by the largest reduced cost.
+//
+// A starting basis may be given, as returned by GetBasis() for a
+// related problem, such as one with rows or columns added.
+// Phase I is then skipped if the basis can be made feasible by dual
+// simplex pivots.
+//
+// Only floating-point arithmetic is supported.  As with LPSolve, all
+// computation is done in the constructor.
+//
+class SparseLPSolve {
+public:
+  SparseLPSolve(const Gambit::Matrix<double> &A,
+		const Gambit::Vector<double> &b,
+		const Gambit::Vector<double> &c, int nequals,
+		const Gambit::Array<int> &p_basis = Gambit::Array<int>(),
+		bool p_steepestEdge = true);
+
+  bool IsFeasible(void) const { return m_feasible; }
+  bool IsBounded(void) const { return m_bounded; }
+  long NumPivots(void) const { return m_numPivots; }
+
+  double OptimumCost(void) const;
+  /// The values of the variables, indexed by the columns of A
+  const Gambit::Vector<double> &OptimumVector(void) const { return m_primal; }
+  /// The values of the dual variables, indexed by the rows of A
+  const Gambit::Vector<double> &DualVector(void) const { return m_dual; }
+  /// The basic variable of each row: j for column j of A, -i for the
+  /// slack of row i.  This may be passed back as a starting basis.
+  Gambit::Array<int> GetBasis(void) const;
+
+private:
+  // The variables are the columns of A, then a slack for each row,
+  // then the artificial variables used in phase I.  All are bounded
+  // below by zero; some are also bounded above by zero (fixed).
+  // The column of variable j is stored in entries m_start[j-1] up to
+  // m_start[j] of m_index and m_value.
+  // The right-hand side, as perturbed to avoid degeneracy
+  int m_numRows;
+  Gambit::Vector<double> m_b;
+  int m_numVars;
+  std::vector<int> m_start, m_index;
+  std::vector<double> m_value;
+  Gambit::Array<bool> m_fixed;
+  Gambit::Vector<double> m_cost, m_reducedCost, m_weight;
+  bool m_steepestEdge;
+
+  // For each row, the variable basic in it; for each variable, the
+  // row it is basic in, or zero
+  Gambit::Array<int> m_head, m_row;
+  EtaFile m_eta;
+  int m_refactorEtas, m_refactorNonzeros;
+  Gambit::Vector<double> m_x;
+
+  bool m_feasible, m_bounded;
+  long m_numPivots;
+  Gambit::Vector<double> m_primal, m_dual;
+
+  double Dot(const Gambit::Vector<double> &, int p_var) const;
+  void Dot(const Gambit::Vector<double> &, const Gambit::Vector<double> &,
+	   int p_var, double &, double &) const;
+  bool PhaseOne(int nequals);
+  bool WarmStart(const Gambit::Array<int> &, const Gambit::Vector<double> &c,
+		 int nequals);
+  void ComputeReducedCosts(void);
+  bool Solve(void);
+  int Enter(void) const;
+  int Exit(const Gambit::Vector<double> &p_alpha, int p_in) const;
+  bool RestoreFeasibility(void);
+  void Pivot(int p_row, int p_in, const Gambit::Vector<double> &p_alpha);
+  void Refactor(void);
+};
+
+#endif  // SPARSELP_H
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #include "libgambit/libgambit.h"
 #include "clique.h"
@@ -48,6 +49,43 @@ bool EqZero(const Rational &x)
 
 int m_stopAfter = 0;
 
+//
+// Whether x is far enough from zero that the product of any two such
+// values fails EqZero()
+//
+bool IsLabelled(const double &x)
+{
+  double eps = ::pow(10.0, -7.5);
+  return (x > eps || x < -eps);
+}
+
+bool IsLabelled(const Rational &x)
+{
+  return (x != Gambit::Rational(0));
+}
+
+const int WORD_BITS = 8 * sizeof(unsigned long);
+
+//
+// Sets the bits, from p_offset on in the words from p_start on, of the
+// p_number strategies that carry a nonzero value in p_bfs: the variables
+// (keys 1, 2, ...) if p_variables is true, otherwise the slacks
+// (-1, -2, ...).
+//
+template <class T> void SetLabels(const BFS<T> &p_bfs, int p_number,
+				  bool p_variables, int p_offset,
+				  std::vector<unsigned long> &p_bits, 
+				  int p_start)
+{
+  for (int k = 1; k <= p_number; k++) {
+    int key = (p_variables) ? k : -k;
+    if (p_bfs.count(key) && IsLabelled(p_bfs[key])) {
+      int bit = p_offset + k - 1;
+      p_bits[p_start + bit / WORD_BITS] |= 1UL << (bit % WORD_BITS);
+    }
+  }
+}
+
 void PrintProfile(std::ostream &p_stream,
 		  const std::string &p_label,
 		  const MixedStrategyProfile<double> &p_profile)
@@ -188,15 +226,40 @@ template <class T> void Solve(const StrategySupport &p_support)
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
+  // A vertex of poly2 is a strategy for player 1, with slacks for the
+  // strategies of player 2; a vertex of poly1 is the other way about.
+  // Mark the strategies each vertex plays, or leaves slack; a pair of
+  // vertices can only be complementary if no strategy is marked in both.
+  int n1 = p_support.NumStrategies(1), n2 = p_support.NumStrategies(2);
+  int words1 = (n1 + WORD_BITS - 1) / WORD_BITS;
+  int words = words1 + (n2 + WORD_BITS - 1) / WORD_BITS;
+  std::vector<unsigned long> labels1(v1 * words, 0), labels2(v2 * words, 0);
+  for (int i1 = 1; i1 <= v1; i1++) {
+    SetLabels(verts1[i1], n1, false, 0, labels1, (i1-1) * words);
+    SetLabels(verts1[i1], n2, true, words1 * WORD_BITS, labels1, (i1-1) * words);
+  }
+  for (int i2 = 1; i2 <= v2; i2++) {
+    SetLabels(verts2[i2], n1, true, 0, labels2, (i2-1) * words);
+    SetLabels(verts2[i2], n2, false, words1 * WORD_BITS, labels2, (i2-1) * words);
+  }
+
   int id1 = 0, id2 = 0;
 
   try {
     for (int i2 = 2; i2 <= v2; i2++) {
-      BFS<T> bfs1 = verts2[i2];
-      i++;
+      const BFS<T> &bfs1 = verts2[i2];
+      const unsigned long *label2 = &labels2[(i2-1) * words];
       for (int i1 = 2; i1 <= v1; i1++) {
-	BFS<T> bfs2 = verts1[i1];
+	const unsigned long *label1 = &labels1[(i1-1) * words];
+	unsigned long clash = 0;
+	for (int w = 0; w < words; w++) {
+	  clash |= label1[w] & label2[w];
+	}
+	if (clash) {
+	  continue;
+	}
+
+	const BFS<T> &bfs2 = verts1[i1];
 	
 	// check if solution is nash 
 	// need only check complementarity, since it is feasible
@@ -321,7 +384,7 @@ int main(int argc, char *argv[])
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
 
-  while ((c = getopt(argc, argv, "d:DhqcS")) != -1) {
+  while ((c = getopt(argc, argv, "d:DhqcLS")) != -1) {
     switch (c) {
     case 'd':
       useFloat = true;
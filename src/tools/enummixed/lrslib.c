@@ -2394,6 +2394,10 @@ pivot (lrs_dic * P, lrs_dat * Q, long bas, long cob)
 	  {
 /*          A[i][j]=(A[i][j]*Ars-A[i][s]*A[r][j])/P->det; */
 
+#ifdef MP
+	    if (pivotint (A[i][j], Ars, A[i][s], A[r][j], P->det, A[i][j]))
+	      continue;		/* done in machine words */
+#endif
 	    mulint (A[i][j], Ars, Nt);
 	    mulint (A[i][s], A[r][j], Ns);
 	    decint (Nt, Ns);
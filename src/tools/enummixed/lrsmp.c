@@ -586,6 +586,94 @@ start:
 }				/* end of normalize */
 
 
+/*********************************************************/
+/* Machine word fast path for the pivot update           */
+/* (a*b-c*d)/e is done in 64 bit arithmetic when all of  */
+/* a..e are below 2^31, in 128 bit arithmetic when they  */
+/* fit in 63 bits and the compiler has a 128 bit type,   */
+/* and otherwise left to the multiple precision code.    */
+/*********************************************************/
+
+#ifdef __SIZEOF_INT128__
+typedef __int128 lrs_wide;
+#else
+typedef long long lrs_wide;
+#endif
+
+#define SMALL(x)	((x) < 2147483648LL && (x) > -2147483648LL)
+
+static long
+mptoll (lrs_mp a, long long *x)	/* x=a, FALSE if a may not fit in 63 bits */
+{
+  long i, la;
+  long long y = 0;
+
+  la = length (a);
+  if (la > LONG_DIGITS + 1)
+    return FALSE;
+  for (i = la - 1; i >= 1; i--)
+    y = y * BASE + a[i];
+  *x = (sign (a) == NEG) ? -y : y;
+  return TRUE;
+}
+
+static void
+widetomp (lrs_wide in, lrs_mp a)	/* convert machine integer to lrs_mp */
+{
+  long i = 1;
+  long sig = POS;
+  long long n;
+
+  if (in < 0)
+    {
+      sig = NEG;
+      in = -in;
+    }
+  while (in > 9223372036854775807LL)	/* peel off digits until 64 bits will do */
+    {
+      a[i++] = (long) (in % BASE);
+      in /= BASE;
+    }
+  n = (long long) in;
+  do
+    {
+      a[i++] = (long) (n % BASE);
+      n /= BASE;
+    }
+  while (n != 0);
+  a[0] = i;
+  if (!(i == 2 && a[1] == 0))
+    storesign (a, sig);
+  if (i > lrs_record_digits)
+    {
+      if ((lrs_record_digits = i) > lrs_digits)
+	digits_overflow ();
+    }
+}
+
+long
+pivotint (lrs_mp a, lrs_mp b, lrs_mp c, lrs_mp d, lrs_mp e, lrs_mp f)
+/* f=(a*b-c*d)/e for exact division; FALSE, f unchanged, if too large */
+{
+  long long na, nb, nc, nd, ne;
+
+  if (!mptoll (a, &na) || !mptoll (b, &nb) || !mptoll (c, &nc) ||
+      !mptoll (d, &nd) || !mptoll (e, &ne))
+    return FALSE;
+
+  if (SMALL (na) && SMALL (nb) && SMALL (nc) && SMALL (nd))
+    {
+      widetomp ((na * nb - nc * nd) / ne, f);
+      return TRUE;
+    }
+#ifdef __SIZEOF_INT128__
+  widetomp (((lrs_wide) na * nb - (lrs_wide) nc * nd) / ne, f);
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
 long 
 mptoi (lrs_mp a)		/* convert lrs_mp to long integer */
 {
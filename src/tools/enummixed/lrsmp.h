@@ -52,6 +52,7 @@
 /* MAXD is 2^(k-1)-1 where k=16,32,64 word size */
 /* MAXD must be at least 2*BASE^2               */
 /* If BASE is 10^k, use "%k.ku" for FORMAT      */
+/* LONG_DIGITS is max k with BASE^k < 2^63       */
 /* INTSIZE is number of bytes for integer       */
 /* 32/64 bit machines                           */
 /***********************************************/
@@ -61,6 +62,7 @@
 #define MAXD 2147483647L
 #define BASE 10000L
 #define BASE_DIG 4
+#define LONG_DIGITS 4
 #define INTSIZE 8L
 #define BIT "32bit"
 #else
@@ -69,6 +71,7 @@
 #define BASE 1000000000L
 #define FORMAT "%9.9lu"
 #define BASE_DIG 9
+#define LONG_DIGITS 2
 #define INTSIZE 16L
 #define BIT "64bit"
 #endif
@@ -174,6 +177,8 @@ void itomp (long in, lrs_mp a);	/* convert integer i to lrs_mp
 void linint (lrs_mp a, long ka, lrs_mp b, long kb);	/* compute a*ka+b*kb --> a                        */
 void mptodouble (lrs_mp a, double *x);	/* convert lrs_mp to double                       */
 long mptoi (lrs_mp a);		/* convert lrs_mp to long integer */
+long pivotint (lrs_mp a, lrs_mp b, lrs_mp c, lrs_mp d, lrs_mp e, lrs_mp f);
+						/* f=(a*b-c*d)/e in machine words, FALSE if too big */
 void mulint (lrs_mp a, lrs_mp b, lrs_mp c);	/* multiply two integers a*b --> c                */
 void normalize (lrs_mp a);	/* normalize lrs_mp after computation             */
 void pmp (const char *name, lrs_mp a);	/* print the long precision integer a             */
@@ -134,15 +134,16 @@ void FillLinearityRow(lrs_dic *P, lrs_dat *Q, int m, int n)
 }
 
 //
-// Build the H-representation for player p1
+// Build the H-representation for player p1.  The problem searched first
+// (p_first) has the nonnegativity rows first, as discussed above.
 //
 void BuildRep(lrs_dic *P, lrs_dat *Q, const StrategySupport &p_support,
-	      int p1, int p2)
+	      int p1, int p2, bool p_first)
 {
   long m=Q->m;       /* number of inequalities      */
   long n=Q->n;       
 
-  if (p1 == 1) {
+  if (!p_first) {
     FillConstraintRows(P, Q, p_support, p1, p2, 1);
     FillNonnegativityRows(P, Q, p_support.NumStrategies(p1) + 1,
 			  p_support.MixedProfileLength(), n);
@@ -163,7 +164,7 @@ void BuildRep(lrs_dic *P, lrs_dat *Q, const StrategySupport &p_support,
 long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 		 lrs_dat *Q2, long *numequilib, 
 		 lrs_mp_vector output1, lrs_mp_vector output2,
-		 const StrategySupport &p_support);
+		 const StrategySupport &p_support, int p_first);
 
 long lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic *P2orig,
 			 lrs_mp_matrix * Lin, long no_output);
@@ -172,15 +173,21 @@ long getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[]);
 
 // This is a modified version of lrs_output from the original, in which
 // we output the equilibria found in Gambit format.
+// Player p_first is the one whose problem Q1 is.
 void nashoutput(lrs_dat *Q1, lrs_mp_vector output1,
 		lrs_dat *Q2, lrs_mp_vector output2,
-		const StrategySupport &p_support);
+		const StrategySupport &p_support, int p_first);
 
 
 
 //
 // This is the main function, based on main() from lrslib's 'nash' driver.
 //
+// The first problem is searched in full, and the second only over the
+// face complementary to each vertex of the first; the search is much
+// cheaper when the first problem is over the player with fewer
+// strategies, so that player's mixed strategies are enumerated first.
+//
 void LrsSolve(const StrategySupport &p_support)
 {
   lrs_dic *P1,*P2; /* structure for holding current dictionary and indices */
@@ -197,6 +204,8 @@ void LrsSolve(const StrategySupport &p_support)
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
   long numequilib=0;            /* number of nash equilibria found                      */
   long oldnum=0;                                                                            
+  int first = (p_support.NumStrategies(1) <= p_support.NumStrategies(2)) ? 1 : 2;
+  int second = 3 - first;
 /* global variables lrs_ifp and lrs_ofp are file pointers for input and output   */
 /* they default to stdin and stdout, but may be overidden by command line parms. */
 
@@ -222,7 +231,7 @@ void LrsSolve(const StrategySupport &p_support)
   }
 
   Q1->nash=TRUE;
-  Q1->n = p_support.NumStrategies(1) + 2;   
+  Q1->n = p_support.NumStrategies(first) + 2;   
   Q1->m = p_support.MixedProfileLength() + 1;
 
   P1 = lrs_alloc_dic (Q1);	/* allocate and initialize lrs_dic */
@@ -230,7 +239,7 @@ void LrsSolve(const StrategySupport &p_support)
     return;
   }
 
-  BuildRep(P1, Q1, p_support, 2, 1);
+  BuildRep(P1, Q1, p_support, second, first, true);
 
   output1 = lrs_alloc_mp_vector (Q1->n + Q1->m);   /* output holds one line of output from dictionary     */
 
@@ -241,14 +250,14 @@ void LrsSolve(const StrategySupport &p_support)
   }
 
   Q2->nash=TRUE;
-  Q2->n = p_support.NumStrategies(2) + 2;   
+  Q2->n = p_support.NumStrategies(second) + 2;   
   Q2->m = p_support.MixedProfileLength() + 1;
 
   P2 = lrs_alloc_dic (Q2);	/* allocate and initialize lrs_dic */
   if (P2 == NULL) {
     return;
   }
-  BuildRep(P2, Q2, p_support, 1, 2);
+  BuildRep(P2, Q2, p_support, first, second, false);
 
   output2 = lrs_alloc_mp_vector (Q2->n + Q2->m);   /* output holds one line of output from dictionary     */
 
@@ -309,7 +318,7 @@ void LrsSolve(const StrategySupport &p_support)
       if (!prune && lrs_getsolution (P1, Q1, output1, col))
 	{ 
            oldnum=numequilib;
-           nash2_main(P1,Q1,P2orig,Q2,&numequilib,output1,output2,p_support);
+           nash2_main(P1,Q1,P2orig,Q2,&numequilib,output1,output2,p_support,first);
 	   if (numequilib > oldnum || Q1->verbose)
 	      {
                 if(Q1->verbose)
@@ -348,7 +357,7 @@ void LrsSolve(const StrategySupport &p_support)
 long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig, 
 		 lrs_dat *Q2, long *numequilib, 
 		 lrs_mp_vector output1, lrs_mp_vector output2,
-		 const StrategySupport &p_support)
+		 const StrategySupport &p_support, int p_first)
 
 
 {
@@ -472,7 +481,7 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 	    (*numequilib)++;
              if (Q2->verbose)
                   prat(" \np1's obj value: ",P2->objnum,P2->objden);
-	     nashoutput(Q1, output1, Q2, output2, p_support);
+	     nashoutput(Q1, output1, Q2, output2, p_support, p_first);
 	}
     }
   while (lrs_getnextbasis (&P2, Q2, prune));
@@ -803,9 +812,16 @@ getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
 	            pivot (P, Q, j, k);
 		    update (P, Q, &j, &k);
                    }
+		   else if (!zero (A[Row[i]][0]))
+		     {
+		       /* the linearity is implied by the others, but cannot hold with them */
+		       if(Q->debug || Q->verbose)
+			 fprintf (lrs_ofp, "\nInconsistent linearities");
+		       return FALSE;
+		     }
 		   else
                      if(Q->debug || Q->verbose)
-		        fprintf(lrs_ofp,"\n*Couldn't remove linearity i=%ld B[i]=%ld",i,B[i]);		   
+		        fprintf(lrs_ofp,"\n*Couldn't remove linearity i=%ld B[i]=%ld",i,B[i]);
                      /* this is not necessarily an error, eg. two identical rows/cols in payoff matrix */
                    }
            }
@@ -983,36 +999,26 @@ printrat (const char *name, lrs_mp Nin, lrs_mp Din)	/*reduce and print Nin/Din
 void
 nashoutput(lrs_dat *Q1, lrs_mp_vector output1,
 	   lrs_dat *Q2, lrs_mp_vector output2,
-	   const StrategySupport &p_support)
+	   const StrategySupport &p_support, int p_first)
 {
   std::cout << "NE";
   // The -1 is because the last entry in the vector is the payoff
   // of the other player
-  long i = 1;
-
-  GamePlayer player1 = p_support.GetGame()->GetPlayer(1);
-  for (int j = 1; j <= player1->NumStrategies(); j++) {
-    if (p_support.Contains(player1->GetStrategy(j))) {
-      std::cout << ",";
-      printrat("", output1[i++], output1[0]);
-    }
-    else {
-      std::cout << ",0";
-    }
-  }
-
-  i = 1;
-  GamePlayer player2 = p_support.GetGame()->GetPlayer(2);
-  for (int j = 1; j <= player2->NumStrategies(); j++) {
-    if (p_support.Contains(player2->GetStrategy(j))) {
-      std::cout << ",";
-      printrat("", output2[i++], output2[0]);
-    }
-    else {
-      std::cout << ",0";
+  for (int pl = 1; pl <= 2; pl++) {
+    lrs_mp_vector output = (pl == p_first) ? output1 : output2;
+    long i = 1;
+
+    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
+    for (int j = 1; j <= player->NumStrategies(); j++) {
+      if (p_support.Contains(player->GetStrategy(j))) {
+	std::cout << ",";
+	printrat("", output[i++], output[0]);
+      }
+      else {
+	std::cout << ",0";
+      }
     }
   }
   std::cout << std::endl;
   fflush(stdout);
 }
-
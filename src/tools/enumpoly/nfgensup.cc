@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
 #include "nfgensup.h"
 
 // We build a series of functions of increasing complexity.  The
@@ -188,7 +189,7 @@ Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::St
 void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
 				      Gambit::StrategySupport *sact,
 				      StrategyCursorForSupport *c,
-				      Gambit::List<Gambit::StrategySupport> &p_list)
+				      std::vector<std::vector<bool> > &p_list)
 { 
   bool abort = false;
   bool no_deletions = true;
@@ -226,7 +227,12 @@ void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
       sact->AddStrategy(actual_deletions[i]);
   }
   if (!abort && no_deletions) {
-    p_list.Append(*sact);
+    std::vector<bool> flags;
+    StrategyCursorForSupport recorder(s);
+    do {
+      flags.push_back(sact->Contains(recorder.GetStrategy()));
+    } while (recorder.GoToNext());
+    p_list.push_back(flags);
     
     StrategyCursorForSupport c_copy(*c);
     do {
@@ -285,49 +291,128 @@ Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::St
   return answer;
 }
   
+//
+// Rebuilds the subsupport of s recorded by PossibleNashSubsupportsRECURSIVE
+//
+static Gambit::StrategySupport 
+SubsupportFromFlags(const Gambit::StrategySupport &s,
+		    const std::vector<bool> &p_flags)
+{
+  Gambit::StrategySupport answer(s);
+  StrategyCursorForSupport crsr(s);
+  int i = 0;
+  do {
+    if (!p_flags[i++]) {
+      answer.RemoveStrategy(crsr.GetStrategy());
+    }
+  } while (crsr.GoToNext());
+  return answer;
+}
+
+//
+// Returns true if some strategy in the subsupport is weakly dominated,
+// either by another strategy in it, or by an inactive strategy.
+//
+static bool HasWeakDomination(const Gambit::StrategySupport &S,
+			      const Gambit::StrategySupport &p_current)
+{
+  Gambit::StrategySupport current(p_current);
+  StrategyCursorForSupport crsr(S);
+  bool remove = false;
+  do {
+    Gambit::GameStrategy strat = crsr.GetStrategy();
+    if (current.Contains(strat)) 
+      for (int j = 1; j <= strat->GetPlayer()->NumStrategies(); j++) {
+	Gambit::GameStrategy other_strat = strat->GetPlayer()->GetStrategy(j);
+	if (other_strat != strat)
+	  if (current.Contains(other_strat)) {
+	    if (current.Dominates(other_strat,strat,false)) 
+	      remove = true;
+	  }
+	  else { 
+	    current.AddStrategy(other_strat);
+	    if (current.Dominates(other_strat,strat,false)) {
+	      remove = true;
+	    }
+	    current.RemoveStrategy(other_strat);
+	  }
+      }
+  } while (crsr.GoToNext() && !remove);
+  return remove;
+}
+  
 Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::StrategySupport &S)
 {
-  Gambit::List<Gambit::StrategySupport> answer;
+  std::vector<std::vector<bool> > candidates;
   Gambit::StrategySupport sact(S);
   StrategyCursorForSupport cursor(S);
-  PossibleNashSubsupportsRECURSIVE(S, &sact, &cursor, answer);
-
-  // At this point answer has all consistent subsupports without
-  // any strong dominations.  We now edit the list, removing all
-  // subsupports that exhibit weak dominations, and we also eliminate
-  // subsupports exhibiting domination by currently inactive strategies.
+  PossibleNashSubsupportsRECURSIVE(S, &sact, &cursor, candidates);
 
-  for (int i = answer.Length(); i >= 1; i--) {
-    Gambit::StrategySupport current(answer[i]);
-    StrategyCursorForSupport crsr(S);
-    bool remove = false;
-    do {
-      Gambit::GameStrategy strat = crsr.GetStrategy();
-      if (current.Contains(strat)) 
-	for (int j = 1; j <= strat->GetPlayer()->NumStrategies(); j++) {
-	  Gambit::GameStrategy other_strat = strat->GetPlayer()->GetStrategy(j);
-	  if (other_strat != strat)
-	    if (current.Contains(other_strat)) {
-	      if (current.Dominates(other_strat,strat,false)) 
-		remove = true;
-	    }
-	    else { 
-	      current.AddStrategy(other_strat);
-	      if (current.Dominates(other_strat,strat,false)) {
-		remove = true;
-	      }
-	      current.RemoveStrategy(other_strat);
-	    }
-      }
-    } while (crsr.GoToNext() && !remove);
-    if (remove)
-      answer.Remove(i);
+  // At this point we have all consistent subsupports without
+  // any strong dominations.  We now remove all subsupports that
+  // exhibit weak dominations, and we also eliminate subsupports
+  // exhibiting domination by currently inactive strategies.
+  Gambit::List<Gambit::StrategySupport> answer;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    Gambit::StrategySupport current(SubsupportFromFlags(S, candidates[i]));
+    if (!HasWeakDomination(S, current)) {
+      answer.Append(current);
+    }
   }
     
   return SortSupportsBySize(answer);
-  return answer;
 }
 
+//----------------------------------------------------
+//           PossibleNashSubsupportIterator
+// ---------------------------------------------------
+
+namespace {
+
+class FlagCountLess {
+private:
+  const std::vector<std::vector<bool> > &m_flags;
+public:
+  FlagCountLess(const std::vector<std::vector<bool> > &p_flags)
+    : m_flags(p_flags) { }
+  bool operator()(int p_a, int p_b) const
+  { return (std::count(m_flags[p_a].begin(), m_flags[p_a].end(), true) <
+	    std::count(m_flags[p_b].begin(), m_flags[p_b].end(), true)); }
+};
+
+} // end anonymous namespace
+
+PossibleNashSubsupportIterator::PossibleNashSubsupportIterator(const Gambit::StrategySupport &S)
+  : m_support(S), m_current(S), m_index(0)
+{
+  Gambit::StrategySupport sact(S);
+  StrategyCursorForSupport cursor(S);
+  PossibleNashSubsupportsRECURSIVE(S, &sact, &cursor, m_candidates);
+
+  for (size_t i = 0; i < m_candidates.size(); i++) {
+    m_order.push_back(i);
+  }
+  std::stable_sort(m_order.begin(), m_order.end(), 
+		   FlagCountLess(m_candidates));
+  Advance();
+}
+
+//
+// Moves to the first candidate, from the current one on, which has no
+// weak dominations, and builds its support.  The flags of candidates
+// passed over are released.
+//
+void PossibleNashSubsupportIterator::Advance(void)
+{
+  for (; m_index < m_order.size(); m_index++) {
+    std::vector<bool> &flags = m_candidates[m_order[m_index]];
+    m_current = SubsupportFromFlags(m_support, flags);
+    std::vector<bool>().swap(flags);
+    if (!HasWeakDomination(m_support, m_current)) {
+      return;
+    }
+  }
+}
 
 //----------------------------------------------------
 //                StrategyCursorForSupport
@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
 #include "libgambit/libgambit.h"
 
 class StrategyCursorForSupport;
@@ -74,15 +75,41 @@ Gambit::List<Gambit::StrategySupport> AllUndominatedSubsupports(const Gambit::St
 // of having active strategys at all active infosets, and not at other
 // infosets.
 
+// The recursion records each subsupport it finds as a flag for each
+// strategy of s, in cursor order.
+
 void PossibleNashSubsupportsRECURSIVE(const Gambit::StrategySupport &s,
 				      Gambit::StrategySupport *sact,
 				      StrategyCursorForSupport *c,
-				      Gambit::List<Gambit::StrategySupport> &list);
+				      std::vector<std::vector<bool> > &list);
 
 Gambit::List<Gambit::StrategySupport> SortSupportsBySize(Gambit::List<Gambit::StrategySupport> &);
   
 Gambit::List<Gambit::StrategySupport> PossibleNashSubsupports(const Gambit::StrategySupport &S);
 
+// Visits the same subsupports as PossibleNashSubsupports, in order of
+// increasing size, without building the list of them.  Only the
+// candidates without strong dominations are found in advance, and are
+// kept as flags; the tests for weak domination, and the construction
+// of the support itself, wait until the iterator reaches each one.
+
+class PossibleNashSubsupportIterator {
+private:
+  Gambit::StrategySupport m_support, m_current;
+  std::vector<std::vector<bool> > m_candidates;
+  std::vector<int> m_order;
+  size_t m_index;
+
+  void Advance(void);
+
+public:
+  PossibleNashSubsupportIterator(const Gambit::StrategySupport &);
+
+  bool AtEnd(void) const { return m_index >= m_order.size(); }
+  void operator++(int) { m_index++; Advance(); }
+  const Gambit::StrategySupport &operator*(void) const { return m_current; }
+};
+
 ///////////////// Utility Cursor Class /////////////////////
 
 class StrategyCursorForSupport {
@@ -144,6 +144,33 @@ void SolveMixed(Game p_nfg)
   }
 }
 
+//
+// Action-graph games are solved in the space of configurations of
+// each player class, rather than by iterating over pure strategy
+// profiles.  One profile is reported for each equilibrium configuration;
+// profiles obtained by permuting players within a class are equivalent.
+//
+void SolveAgg(Game p_game, bool p_quiet)
+{
+  agg *aggPtr = dynamic_cast<GameAggRep &>(*p_game).GetUnderlyingAGG();
+  std::vector<agg::ClassConfig> equilibria;
+  long configs = aggPtr->getPureNash(equilibria);
+
+  std::vector<int> profile(p_game->NumPlayers());
+  for (size_t i = 0; i < equilibria.size(); i++) {
+    aggPtr->getPureProfile(&profile[0], equilibria[i]);
+    MixedStrategyProfile<Rational> temp(p_game->NewMixedStrategyProfile(Rational(0)));
+    ((Vector<Rational> &) temp).operator=(Rational(0));
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      temp[p_game->GetPlayer(pl)->GetStrategy(profile[pl-1] + 1)] = 1;
+    }
+    PrintProfile(std::cout, temp);
+  }
+
+  if (!p_quiet) {
+    std::cerr << "Examined " << configs << " configurations\n";
+  }
+}
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -208,7 +235,10 @@ int main(int argc, char *argv[])
   try {
     Game game = ReadGame(std::cin);
 
-    if (!game->IsTree() || useStrategic) {
+    if (dynamic_cast<GameAggRep *>(game.operator->())) {
+      SolveAgg(game, quiet);
+    }
+    else if (!game->IsTree() || useStrategic) {
       game->BuildComputedValues();
       SolveMixed(game);
     }
@@ -0,0 +1,73 @@
+/* Copyright 2002 Ben Blum, Christian Shelton
+ *
+ * This file is part of GameTracer.
+ *
+ * GameTracer is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * GameTracer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GameTracer; if not, write to the Free Software Foundation, 
+ * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cassert>
+#include "cmatrix.h"
+#include "aggame.h"
+
+aggame::aggame(agg *aggPtr, double offset, double scale) 
+  : gnmgame(aggPtr->getNumPlayers(), aggPtr->actions), aggPtr(aggPtr),
+    offset(offset), scale(scale), profile(aggPtr->getNumActions()),
+    rows(aggPtr->getNumActions()) {
+}
+
+aggame::~aggame() {
+}
+
+double aggame::getPurePayoff(int player, int *s) {
+  return (aggPtr->getPurePayoff(player, s) + offset) * scale;
+}
+
+void aggame::setPurePayoff(int player, int *s, double value) {
+  assert(0);
+}
+
+void aggame::setProfile(cvector &s) {
+  for(int i = 0; i < numActions; i++) {
+    profile[i] = s[i];
+  }
+}
+
+double aggame::getMixedPayoff(int player, cvector &s) {
+  setProfile(s);
+  return (aggPtr->getMixedPayoff(player, profile) + offset) * scale;
+}
+
+void aggame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
+  setProfile(s);
+  for(int i = 0; i < numActions; i++) {
+    rows[i] = dest[i];
+  }
+  aggPtr->payoffMatrix(&rows[0], profile, fuzz);
+
+  // The blocks on the diagonal only hold the fuzz pattern
+  if(offset != 0.0 || scale != 1.0) {
+    for(int rown = 0; rown < numPlayers; rown++) {
+      for(int coln = 0; coln < numPlayers; coln++) {
+	if(coln == rown)
+	  continue;
+	for(int rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(int coli = firstAction(coln); coli < lastAction(coln); coli++) {
+	    dest[rowi][coli] = (dest[rowi][coli] + offset) * scale;
+	  }
+	}
+      }
+    }
+  }
+}
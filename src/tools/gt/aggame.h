@@ -0,0 +1,55 @@
+/* Copyright 2002 Ben Blum, Christian Shelton
+ *
+ * This file is part of GameTracer.
+ *
+ * GameTracer is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * GameTracer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GameTracer; if not, write to the Free Software Foundation, 
+ * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __AGGAME_H
+#define __AGGAME_H
+
+#include <vector>
+#include "gnmgame.h"
+#include "cmatrix.h"
+#include "agg.h"
+
+// aggame wraps an action-graph game, so that GNM and IPA can run on it
+// without expanding it to normal form.  The payoffs seen through this
+// class are those of the agg, plus offset and times scale.
+class aggame : public gnmgame {
+ public:
+  aggame(agg *aggPtr, double offset = 0.0, double scale = 1.0);
+  ~aggame();
+
+  double getPurePayoff(int player, int *s);
+  // The payoffs are those of the agg; they cannot be changed here.
+  void setPurePayoff(int player, int *s, double value);
+
+  double getMixedPayoff(int player, cvector &s);
+  // This uses the agg's own Jacobian computation, which works on the
+  // distributions over configurations of each action node's neighbours.
+  void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
+
+ private:
+  // Copies s into the profile type used by the agg
+  void setProfile(cvector &s);
+
+  agg *aggPtr;
+  double offset, scale;
+  StrategyProfile profile;
+  std::vector<double *> rows;
+};
+
+#endif
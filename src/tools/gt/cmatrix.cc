@@ -20,7 +20,7 @@
 #include "cmatrix.h"
 #include "math.h"
 #include "float.h"
-#include "libgambit/matrix.h"
+#include <vector>
 
 cvector::~cvector() { delete []x; }
 // adopted from NRiC, pg 45
@@ -59,12 +59,19 @@ cmatrix cmatrix::inv(bool &worked) const {
 }
 
 // adopted from NRiC, pg 43
+// This is the same factorisation, with the same pivots and the same
+// sequence of floating point operations on each entry, but computed
+// right-looking a block of LUBLOCK columns at a time: each row of the
+// trailing submatrix is updated by a whole block of pivot rows with
+// unit-stride inner loops, rather than by one dot product per entry.
+#define LUBLOCK 48
+#define LUTILE 256
 int cmatrix::LUdecomp(cmatrix &LU, int *ix) const {
 	if (m!=n||LU.m!=LU.n||LU.n!=n) {
 		cerr << "invalid cmatrix in LUdecomp" << endl;
 		exit(1);
 	}
-	int d=1,i,j,k;
+	int d=1,i,j,k,c;
 	LU = *this;
 	double *vv = new double[n];
 	double dum;
@@ -79,40 +86,69 @@ int cmatrix::LUdecomp(cmatrix &LU, int *ix) const {
 		}
 		vv[i] = 1/vv[i];
 	}
-	double sum,big;
-	int imax;
-	for(j=0;j<n;j++) {
-		for(i=0;i<j;i++) {
-			sum = LU.x[i*n+j];
-			for(k=0;k<i;k++) sum -= LU.x[i*n+k]*LU.x[k*n+j];
-			LU.x[i*n+j] = sum;
-		}
-		big = 0;
-		for(i=j;i<n;i++) {
-			sum = LU.x[i*n+j];
-			for(k=0;k<j;k++) sum -= LU.x[i*n+k]*LU.x[k*n+j];
-			LU.x[i*n+j] = sum;
-			if ((dum=vv[i]*fabs(sum))>=big) {
-				big = dum;
-				imax = i;
+	double big, f, *a = LU.x, *ri, *rk;
+	int imax, k0, k1, c0, c1;
+	for(k0=0;k0<n;k0=k1) {
+		k1 = (k0+LUBLOCK < n) ? k0+LUBLOCK : n;
+
+		// factor the columns of the block
+		for(j=k0;j<k1;j++) {
+			big = 0;
+			imax = j;
+			for(i=j;i<n;i++) {
+				if ((dum=vv[i]*fabs(a[i*n+j]))>=big) {
+					big = dum;
+					imax = i;
+				}
 			}
-		}
-		if (j!=imax) {
-			for(k=0;k<n;k++) {
-				dum = LU.x[imax*n+k];
-				LU.x[imax*n+k] = LU.x[j*n+k];
-				LU.x[j*n+k] = dum;
+			if (j!=imax) {
+				for(k=0;k<n;k++) {
+					dum = a[imax*n+k];
+					a[imax*n+k] = a[j*n+k];
+					a[j*n+k] = dum;
+				}
+				d = -d;
+				vv[imax] = vv[j];
+			}
+			ix[j] = imax;
+			if (a[j*n+j] == 0) {
+				a[j*n+j] = (double)1.0e-20;
+			}
+			if (j!=n-1) {
+				dum = 1/a[j*n+j];
+				rk = a+j*n;
+				for(i=j+1;i<n;i++) {
+					ri = a+i*n;
+					ri[j] *= dum;
+					f = ri[j];
+					for(c=j+1;c<k1;c++) ri[c] -= f*rk[c];
+				}
 			}
-			d = -d;
-			vv[imax] = vv[j];
 		}
-		ix[j] = imax;
-		if (LU.x[j*n+j] == 0) {
-			LU.x[j*n+j] = (double)1.0e-20;
+		if (k1==n) break;
+
+		// the block's rows of U, right of the block
+		for(i=k0+1;i<k1;i++) {
+			ri = a+i*n;
+			for(k=k0;k<i;k++) {
+				f = ri[k];
+				rk = a+k*n;
+				for(c=k1;c<n;c++) ri[c] -= f*rk[c];
+			}
 		}
-		if (j!=n-1) {
-			dum = 1/LU.x[j*n+j];
-			for(i=j+1;i<n;i++) LU.x[i*n+j] *= dum;
+
+		// the trailing submatrix, in tiles of columns so that the
+		// block's rows of U stay in cache
+		for(c0=k1;c0<n;c0=c1) {
+			c1 = (c0+LUTILE < n) ? c0+LUTILE : n;
+			for(i=k1;i<n;i++) {
+				ri = a+i*n;
+				for(k=k0;k<k1;k++) {
+					f = ri[k];
+					rk = a+k*n;
+					for(c=c0;c<c1;c++) ri[c] -= f*rk[c];
+				}
+			}
 		}
 	}
 	delete []vv;
@@ -401,11 +437,10 @@ double cmatrix::adjoint() {
   std::vector<int> r(m);
   std::vector<int> r2(m);
   std::vector<int> c(m);
-  double D = 1.0;
-  Gambit::Matrix<double> retval(0, m-1, 0, m-1);
-  for(i = 0; i < m; i++)
-    for(j = 0; j < m; j++)
-      retval(i, j) = x[i*n+j];
+  double D = 1.0, f, *row, *prow;
+  // the elimination works on a plain copy of the rows, so that each
+  // row update is a unit-stride loop
+  std::vector<double> a(x, x + m*n);
 
   for(i= 0; i < m; i++) {
     r[i] = -1;
@@ -416,8 +451,8 @@ double cmatrix::adjoint() {
     max = -1.0;
     maxi = -1;
     for(i = 0; i < m; i++) {
-      if(r[i] < 0 && fabs(retval(i,j)) > max) {
-	max = fabs(retval(i,j));
+      if(r[i] < 0 && fabs(a[i*n+j]) > max) {
+	max = fabs(a[i*n+j]);
 	maxi = i;
       }
     }
@@ -434,22 +469,24 @@ double cmatrix::adjoint() {
     }
 
     i = maxi;
-    pivot = retval(i,j);
+    pivot = a[i*n+j];
+    prow = &a[i*n];
     for(i0 = 0; i0 < m; i0++) {
       if(i0 != i) {
+	// column j is overwritten below; the loop runs over it too, so
+	// restore it afterwards
+	row = &a[i0*n];
+	f = row[j];
 	for(j0 = 0; j0 < m; j0++) {
-	  if(j0 != j) {
-	    retval(i0,j0) *= pivot;
-	    retval(i0,j0) -= retval(i0,j) * retval(i,j0);
-	    retval(i0,j0) /= D;
-	  }
+	  row[j0] = (row[j0] * pivot - f * prow[j0]) / D;
 	}
+	row[j] = f;
       }
     }
     for(i0 = 0; i0 < m; i0++) {
-      retval(i0,j) = -retval(i0,j);
+      a[i0*n+j] = -a[i0*n+j];
     }
-    retval(i,j) = D;
+    a[i*n+j] = D;
     D = pivot;
     r[i] = j;
     c[j] = i;
@@ -473,7 +510,7 @@ double cmatrix::adjoint() {
   }
   for(i = 0; i < m; i++)
     for(j = 0; j < m; j++)
-      x[i*n+j] = retval(c[i],r[j]);
+      x[i*n+j] = a[c[i]*n+r[j]];
   if(s%2 == 1) {
     negate();
     D = -D;
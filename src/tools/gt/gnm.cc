@@ -38,8 +38,24 @@ void PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-// gnm(A,g,Eq,steps,fuzz,LNMFreq,LNMMax,LambdaMin,wobble,threshold)
-// ----------------------------------------------------------------
+// Returns true if sigma differs from each of the equilibria in reported
+// by more than eqTol in some component, and if so adds it to reported.
+static bool NewEquilibrium(std::vector<cvector> &reported, const cvector &sigma, double eqTol) {
+  for(unsigned int e = 0; e < reported.size(); e++) {
+    int i;
+    for(i = 0; i < sigma.getm(); i++) {
+      if(fabs(reported[e][i] - sigma[i]) > eqTol)
+	break;
+    }
+    if(i == sigma.getm())
+      return false;
+  }
+  reported.push_back(sigma);
+  return true;
+}
+
+// gnm(A,g,Eq,steps,fuzz,LNMFreq,LNMMax,LambdaMin,wobble,threshold,reported,eqTol)
+// -------------------------------------------------------------------------
 // This executes the GNM algorithm on game A.
 // Interpretation of parameters:
 // g: perturbation ray.
@@ -63,8 +79,12 @@ void PrintProfile(std::ostream &p_stream,
 // threshold: the equilibrium error threshold for doing a wobble.  If
 //            wobbles are disabled, GNM will terminate if the error
 //            reaches this threshold.
+// reported: if not null, the equilibria printed so far, possibly by
+//           calls tracing other rays on the same game.  An equilibrium
+//           within eqTol of one of these in every component is stored
+//           in Eq but not printed again.
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold) {
+int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, std::vector<cvector> *reported, double eqTol) {
   int i, // utility variables
     bestAction,  
     k, 
@@ -311,7 +331,9 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	    Eq[numEq] = new cvector(M);
 	    *(Eq[numEq++]) = sigma;
 
-	    PrintProfile(std::cout, "NE", sigma);
+	    if(!reported || NewEquilibrium(*reported, sigma, eqTol)) {
+	      PrintProfile(std::cout, "NE", sigma);
+	    }
 	  }
 	  Index = -Index;
 	  s_hat_old = -1;
@@ -23,6 +23,8 @@
 #include "cmatrix.h"
 #include "gnmgame.h"
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold);
+#include <vector>
+
+int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, std::vector<cvector> *reported = 0, double eqTol = 0.0);
 
 #endif
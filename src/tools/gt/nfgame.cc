@@ -26,6 +26,13 @@ nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(n
   for(int i = 1; i <= numPlayers; i++) {
     blockSize[i] = blockSize[i-1]*actions[i-1];
   }
+  // payoffBlocks halves the columns at each level; the outer vector is
+  // never resized afterwards, so pointers into the buffers stay valid.
+  int levels = 1;
+  for(int n = 1; n < numPlayers; n *= 2) {
+    levels++;
+  }
+  scratch.resize(2*levels);
 }
 
 nfgame::~nfgame() {
@@ -39,120 +46,128 @@ int nfgame::findIndex(int player, int *s) {
   return retIndex;
 }
 
-double nfgame::getMixedPayoff(int player, cvector &s) {
-  double *m = new double[blockSize[numPlayers]];
-  try {
-    memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
-    double p = localPayoff(s, m, numPlayers);
-    delete [] m;
-    return p;
+double *nfgame::getScratch(int index, int size) {
+  if((int) scratch[index].size() < size) {
+    scratch[index].resize(size);
   }
-  catch (...) {
-    delete [] m;
-    throw;
+  return &scratch[index][0];
+}
+
+double nfgame::getMixedPayoff(int player, cvector &s) {
+  std::vector<int> players(numPlayers);
+  for(int i = 0; i < numPlayers; i++) {
+    players[i] = i;
   }
+  std::vector<int> remove(players);
+  return *contractAll(payoffs.values() + player * blockSize[numPlayers],
+		      players, &remove[0], numPlayers, 0, s);
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
-  int rown, coln, rowi, coli;
+  int rown, rowi, coli;
   double fuzzcount;
-  double *m = new double[blockSize[numPlayers]];
-  double *local = new double[maxActions*maxActions];
-  try {
-    for(rown = 0; rown < numPlayers; rown++) {
-      for(coln = 0; coln < numPlayers; coln++) {
-	if(rown == coln) {
-	  fuzzcount = fuzz;
-	  for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
-	      dest[rowi][coli]=fuzzcount;
-	      fuzzcount += fuzz;
-	    }
-	  }
-	} else {
-	  // set m to be the payoffs for player rown
-	  memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
-	  localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
-	  for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
-	      if(rown > coln) {
-		dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
-	      } else {
-		dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
-	      }
-	    }
-	  }
+  std::vector<int> players(numPlayers), cols(numPlayers);
+  for(rown = 0; rown < numPlayers; rown++) {
+    fuzzcount = fuzz;
+    for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+      for(coli=firstAction(rown); coli < lastAction(rown); coli++) {
+	dest[rowi][coli]=fuzzcount;
+	fuzzcount += fuzz;
+      }
+    }
+
+    if(numPlayers > 1) {
+      int ncols = 0;
+      for(int i = 0; i < numPlayers; i++) {
+	players[i] = i;
+	if(i != rown) {
+	  cols[ncols++] = i;
 	}
       }
+      payoffBlocks(dest, rown, payoffs.values() + rown * blockSize[numPlayers],
+		   players, &cols[0], ncols, 0, s);
     }
-    delete [] local;
-    delete [] m;
-  }
-  catch (...) {
-    delete [] local;
-    delete [] m;
-    throw;
   }
 }
 
-
-//assumes m = memcpy(m, payoffs + blockSize[numPlayers] * player1, blockSize[numPlayers]*sizeof(double)), player1 != player2
-//i.e. m points to payoff cmatrix for the desired player
-
-void nfgame::localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n) {
-  int i;
-  if(player1 == n) {
-    for(i = 0; i < actions[player1]; i++) {
-      localPayoffVector(dest+i*actions[player2], player2, s, m+i*blockSize[player1], n-1);
-    }
-  } else if(player2 == n) {
-    for(i = 0; i < actions[player2]; i++) {
-      localPayoffVector(dest+i*actions[player1], player1, s, m+i*blockSize[player2], n-1);
+void nfgame::payoffBlocks(cmatrix &dest, int row, const double *m, std::vector<int> &players, int *cols, int n, int level, cvector &s) {
+  if(n == 1) {
+    // m is now over players row and cols[0] only
+    int col = cols[0], rowi, coli;
+    for(rowi = 0; rowi < actions[row]; rowi++) {
+      for(coli = 0; coli < actions[col]; coli++) {
+	if(row < col) {
+	  dest[rowi + firstAction(row)][coli + firstAction(col)] = m[rowi + coli*actions[row]];
+	} else {
+	  dest[rowi + firstAction(row)][coli + firstAction(col)] = m[coli + rowi*actions[col]];
+	}
+      }
     }
-  } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffMatrix(dest, player1, player2, s, m, n-1);
+    return;
   }
+
+  int half = n / 2;
+  std::vector<int> sub(players);
+  const double *t = contractAll(m, sub, cols + half, n - half, level, s);
+  payoffBlocks(dest, row, t, sub, cols, half, level + 1, s);
+  sub = players;
+  t = contractAll(m, sub, cols, half, level, s);
+  payoffBlocks(dest, row, t, sub, cols + half, n - half, level + 1, s);
 }
 
-double *nfgame::scaleMatrix(cvector &s, double *m, int n) {
-  int i,j, curbase, newbase = -1;
-  double scale;
-  for(i = 0; i < actions[n]; i++) {
-    if(s[i+firstAction(n)] > 0.0) {
-      scale = s[i+firstAction(n)];
-      curbase = i*blockSize[n];
-      if(newbase < 0) {
-	newbase = curbase;
-	for(j = curbase; j < curbase+blockSize[n]; j++) {
-	  m[j] *= scale;
-	}
-      } else {
-	for(j = 0; j < blockSize[n]; j++) {
-	  m[newbase + j] += scale * m[curbase+j];
-	}
+const double *nfgame::contractAll(const double *m, std::vector<int> &players, const int *remove, int n, int level, cvector &s) {
+  const double *src = m;
+  for(int i = n - 1, buffer = 0; i >= 0; i--, buffer = 1 - buffer) {
+    int size = 1;
+    for(unsigned int j = 0; j < players.size(); j++) {
+      if(players[j] != remove[i]) {
+	size *= actions[players[j]];
       }
     }
+    double *dest = getScratch(2*level + buffer, size);
+    contract(dest, src, players, remove[i], s);
+    src = dest;
   }
-  return m+newbase;
+  return src;
 }
 
-void nfgame::localPayoffVector(double *dest, int player, cvector &s, double *m, int n) {
-  if(player == n) {
-    for(int i = 0; i < actions[player]; i++) {
-      dest[i] = localPayoff(s, m+i*blockSize[player], n-1);
+void nfgame::contract(double *dest, const double *m, std::vector<int> &players, int k, cvector &s) {
+  int inner = 1, outer = 1, pos = 0;
+  for(unsigned int j = 0; j < players.size(); j++) {
+    if(players[j] < k) {
+      inner *= actions[players[j]];
+    } else if(players[j] > k) {
+      outer *= actions[players[j]];
+    } else {
+      pos = j;
     }
-  } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffVector(dest, player, s, m, n-1);
   }
-}
+  players.erase(players.begin() + pos);
 
-double nfgame::localPayoff(cvector &s, double *m, int n) {
-  if(n < 0)
-    return *m;
-  else {
-    m = scaleMatrix(s, m, n);
-    return localPayoff(s, m, n-1);
+  // As before, only actions played with positive probability contribute
+  int n = actions[k], i, o, a;
+  for(o = 0; o < outer; o++, dest += inner, m += n*inner) {
+    bool started = false;
+    for(a = 0; a < n; a++) {
+      double scale = s[a + firstAction(k)];
+      if(scale > 0.0) {
+	const double *cur = m + a*inner;
+	if(!started) {
+	  for(i = 0; i < inner; i++) {
+	    dest[i] = scale * cur[i];
+	  }
+	  started = true;
+	} else {
+	  for(i = 0; i < inner; i++) {
+	    dest[i] += scale * cur[i];
+	  }
+	}
+      }
+    }
+    if(!started) {
+      for(i = 0; i < inner; i++) {
+	dest[i] = 0.0;
+      }
+    }
   }
 }
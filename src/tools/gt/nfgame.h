@@ -20,6 +20,7 @@
 #ifndef __NFGAME_H
 #define __NFGAME_H
 
+#include <vector>
 #include "gnmgame.h"
 #include "cmatrix.h"
 
@@ -44,12 +45,28 @@ class nfgame : public gnmgame {
 
  private:
   int findIndex(int player, int *s);
-  void localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n);
-  void localPayoffVector(double *dest, int player, cvector &s, double *m, int n);
-  double localPayoff(cvector &s, double *m, int n);
-  double *scaleMatrix(cvector &s, double *m, int n);
+
+  // The payoff tensors are contracted against s one player at a time.
+  // A tensor over the players in the (increasing) list 'players' is
+  // stored with the action of the lowest-numbered player varying fastest.
+
+  // Contracts player k out of the tensor m into dest, and removes k
+  // from players.
+  void contract(double *dest, const double *m, std::vector<int> &players, int k, cvector &s);
+  // Contracts out each player in remove[0..n-1], using the pair of
+  // scratch buffers for the given level, and returns the result; this
+  // is m itself if there is nothing to remove.
+  const double *contractAll(const double *m, std::vector<int> &players, const int *remove, int n, int level, cvector &s);
+  // Stores the blocks of the Jacobian in row player's rows and the
+  // columns of cols[0..n-1], given player row's tensor m over row and
+  // those players.  The tensor is split between the two halves of the
+  // columns, so each contraction is shared by all blocks below it.
+  void payoffBlocks(cmatrix &dest, int row, const double *m, std::vector<int> &players, int *cols, int n, int level, cvector &s);
+  double *getScratch(int index, int size);
+
   cvector payoffs;
   int *blockSize;
+  std::vector<std::vector<double> > scratch;
 };
 
 #endif
@@ -27,6 +27,7 @@
 #include "libgambit/libgambit.h"
 
 #include "nfgame.h"
+#include "aggame.h"
 #include "gnmgame.h"
 #include "gnm.h"
 
@@ -38,6 +39,7 @@ const int LNMMAX = 10;
 const double LAMBDAMIN = -10.0;
 const bool WOBBLE = false;
 const double THRESHOLD = 1e-2;
+const double EQTOL = 1e-6;
 
 int g_numDecimals = 6;
 bool g_verbose = false;
@@ -92,13 +94,16 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-void Solve(const Gambit::Game &p_game)
+// Returns the gametracer representation of the game, with payoffs
+// (u - minPay) * scale.  Action-graph games are used directly; other
+// games are expanded to their payoff tables.
+gnmgame *CreateGame(const Gambit::Game &p_game, 
+		    const Gambit::Rational &minPay, double scale)
 {
-  int i;
-
-  Gambit::Rational maxPay = p_game->GetMaxPayoff();
-  Gambit::Rational minPay = p_game->GetMinPayoff();
-  double scale = 1.0 / (maxPay - minPay);
+  if (Gambit::GameAggRep *aggGame = 
+      dynamic_cast<Gambit::GameAggRep *>(p_game.operator->())) {
+    return new aggame(aggGame->GetUnderlyingAGG(), -(double) minPay, scale);
+  }
 
   int *actions = new int[p_game->NumPlayers()];
   int veclength = p_game->NumPlayers();
@@ -122,9 +127,25 @@ void Solve(const Gambit::Game &p_game)
 		       scale);
     }
   }
+  delete [] actions;
+  delete [] profile;
+  return A;
+}
+
+void Solve(const Gambit::Game &p_game)
+{
+  int i;
+
+  Gambit::Rational maxPay = p_game->GetMaxPayoff();
+  Gambit::Rational minPay = p_game->GetMinPayoff();
+  double scale = 1.0 / (maxPay - minPay);
+
+  gnmgame *A = CreateGame(p_game, minPay, scale);
 
   cvector g(A->getNumActions()); // choose a random perturbation ray
   int numEq;
+  // rays often lead to the same equilibria; each is printed only once
+  std::vector<cvector> reported;
 
   if (g_startFile != "") {
     std::ifstream startVectors(g_startFile.c_str());
@@ -137,7 +158,8 @@ void Solve(const Gambit::Game &p_game)
 	  PrintProfile(std::cout, "pert", g);
 	}
 
-	numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
+	numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
+		  &reported, EQTOL);
 	for (i = 0; i < numEq; i++) {
 	  free(answers[i]);
 	}
@@ -159,7 +181,8 @@ void Solve(const Gambit::Game &p_game)
       if (g_verbose) {
 	PrintProfile(std::cout, "pert", g);
       }
-      numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
+      numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
+		  &reported, EQTOL);
       for (i = 0; i < numEq; i++) {
 	free(answers[i]);
       }
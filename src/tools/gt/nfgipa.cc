@@ -27,6 +27,7 @@
 #include "libgambit/libgambit.h"
 
 #include "nfgame.h"
+#include "aggame.h"
 #include "ipa.h"
 
 #define ALPHA 0.02
@@ -66,9 +67,14 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
+// Returns the gametracer representation of the game.  Action-graph
+// games are used directly; other games are expanded to their payoff tables.
+gnmgame *CreateGame(const Gambit::Game &p_game)
 {
-  int i;
+  if (Gambit::GameAggRep *aggGame = 
+      dynamic_cast<Gambit::GameAggRep *>(p_game.operator->())) {
+    return new aggame(aggGame->GetUnderlyingAGG());
+  }
 
   int *actions = new int[p_game->NumPlayers()];
   int veclength = p_game->NumPlayers();
@@ -90,6 +96,16 @@ void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
       A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
     }
   }
+  delete [] actions;
+  delete [] profile;
+  return A;
+}
+
+void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
+{
+  int i;
+
+  gnmgame *A = CreateGame(p_game);
 
   cvector g(A->getNumActions()); // perturbation ray
   int numEq;
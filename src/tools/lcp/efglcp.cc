@@ -24,12 +24,14 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <iostream>
+#include <map>
 #include "libgambit/libgambit.h"
 
 using namespace Gambit;
 
 #include "lhtab.h"
 #include "lemketab.h"
+#include "sparsetab.h"
 
 extern int g_numDecimals;
 extern int g_stopAfter;
@@ -51,6 +53,33 @@ public:
   const char *what(void) const throw() { return "Reached target number of equilibria"; }
 };
 
+//
+// Accumulates the entries of a sparse matrix, with columns numbered
+// from zero, through the element access interface of Matrix<T>.
+//
+class SparseMatrixBuilder {
+private:
+  Array<std::map<int, double> > m_columns;
+
+public:
+  SparseMatrixBuilder(int p_maxCol) : m_columns(0, p_maxCol) { }
+
+  double &operator()(int r, int c) { return m_columns[c][r]; }
+
+  void GetColumns(Array<SparseColumn> &p_columns) const
+  {
+    for (int c = m_columns.First(); c <= m_columns.Last(); c++) {
+      p_columns[c].clear();
+      for (std::map<int, double>::const_iterator entry = m_columns[c].begin();
+	   entry != m_columns[c].end(); ++entry) {
+	if (entry->second != 0.0) {
+	  p_columns[c].push_back(*entry);
+	}
+      }
+    }
+  }
+};
+
 } // end anonymous namespace
 
 
@@ -159,15 +188,22 @@ private:
   T maxpay,eps;
   List<BFS<T> > m_list;
   List<GameInfoset> isets1, isets2;
+  // Position in isets1 (isets2) of each infoset of player 1 (2), and
+  // the sequence preceding the first action at each of those infosets
+  Array<int> isetno1, isetno2, seqno1, seqno2;
 
-  void FillTableau(const BehavSupport &, Matrix<T> &, const GameNode &, T,
+  template <class M>
+  void FillTableau(const BehavSupport &, M &, const GameNode &, T,
 		   int, int, int, int);
   int AddBFS(const LTableau<T> &tab);
   int AllLemke(const BehavSupport &, int dup, LTableau<T> &B,
 	       int depth, Matrix<T> &,
 	       bool p_print, List<MixedBehavProfile<T> > &);
+  bool SolveSparse(const BehavSupport &, bool p_print,
+		   List<MixedBehavProfile<T> > &);
   
-  void GetProfile(const BehavSupport &, const LTableau<T> &tab, 
+  template <class Tab>
+  void GetProfile(const BehavSupport &, const Tab &tab, 
 		  MixedBehavProfile<T> &, const Vector<T> &, 
 		  const GameNode &n, int,int);
 
@@ -242,11 +278,39 @@ SolveEfgLcp<T>::Solve(const BehavSupport &p_support, bool p_print /*= true*/)
 
   ntot = ns1+ns2+ni1+ni2;
 
-  Matrix<T> A(1,ntot,0,ntot);
-  Vector<T> b(1,ntot);
+  isetno1 = Array<int>(p_support.GetGame()->GetPlayer(1)->NumInfosets());
+  seqno1 = Array<int>(isets1.Length());
+  for (i = 1, j = 1; i <= isets1.Length(); i++) {
+    isetno1[isets1[i]->GetNumber()] = i;
+    seqno1[i] = j;
+    j += p_support.NumActions(1, isets1[i]->GetNumber());
+  }
+  isetno2 = Array<int>(p_support.GetGame()->GetPlayer(2)->NumInfosets());
+  seqno2 = Array<int>(isets2.Length());
+  for (i = 1, j = 1; i <= isets2.Length(); i++) {
+    isetno2[isets2[i]->GetNumber()] = i;
+    seqno2[i] = j;
+    j += p_support.NumActions(2, isets2[i]->GetNumber());
+  }
 
   maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
+  List<MixedBehavProfile<T> > solutions;
+  if (g_stopAfter == 1) {
+    try {
+      if (SolveSparse(p_support, p_print, solutions)) {
+	return solutions;
+      }
+    }
+    catch (...) {
+      // catch exception; return solutions computed (if any)
+      return solutions;
+    }
+  }
+
+  Matrix<T> A(1,ntot,0,ntot);
+  Vector<T> b(1,ntot);
+
   T prob = (T)1;
   for (i = A.MinRow(); i <= A.MaxRow(); i++) {
     b[i] = (T) 0;
@@ -271,7 +335,6 @@ SolveEfgLcp<T>::Solve(const BehavSupport &p_support, bool p_print /*= true*/)
   
   MixedBehavProfile<T> profile(p_support);
   Vector<T> sol(tab.MinRow(),tab.MaxRow());
-  List<MixedBehavProfile<T> > solutions;
   
   try {
     if (g_stopAfter != 1) {
@@ -293,10 +356,13 @@ SolveEfgLcp<T>::Solve(const BehavSupport &p_support, bool p_print /*= true*/)
 		 profile,sol,p_support.GetGame()->GetRoot(),1,1);
       UndefinedToCentroid(profile);
 
-      PrintProfile(std::cout, "NE", profile);
-      if (g_printDetail) {
-	PrintProfileDetail(std::cout, profile);
+      if (p_print) {
+	PrintProfile(std::cout, "NE", profile);
+	if (g_printDetail) {
+	  PrintProfileDetail(std::cout, profile);
+	}
       }
+      solutions.Append(profile);
     }
   }
   catch (...) {
@@ -306,6 +372,64 @@ SolveEfgLcp<T>::Solve(const BehavSupport &p_support, bool p_print /*= true*/)
   return solutions;
 }
 
+//
+// Computes the single equilibrium at the end of the path from the
+// primary ray.  Only floating-point arithmetic has a sparse
+// implementation; the generic version declines, and the dense
+// tableau is used instead.
+//
+template <class T> bool
+SolveEfgLcp<T>::SolveSparse(const BehavSupport &, bool,
+			    List<MixedBehavProfile<T> > &)
+{
+  return false;
+}
+
+template <> bool
+SolveEfgLcp<double>::SolveSparse(const BehavSupport &p_support, bool p_print,
+				 List<MixedBehavProfile<double> > &p_solutions)
+{
+  int ntot = ns1+ns2+ni1+ni2;
+
+  SparseMatrixBuilder A(ntot);
+  FillTableau(p_support, A, p_support.GetGame()->GetRoot(), 1.0, 1, 1, 0, 0);
+  for (int i = 1; i <= ntot; i++) { 
+    A(i,0) = -1.0;
+  }
+  A(1,ns1+ns2+1) = 1.0;
+  A(ns1+ns2+1,1) = -1.0;
+  A(ns1+1,ns1+ns2+ni1+1) = 1.0;
+  A(ns1+ns2+ni1+1,ns1+1) = -1.0;
+
+  Array<SparseColumn> columns(0, ntot);
+  A.GetColumns(columns);
+  Vector<double> b(1, ntot);
+  b = 0.0;
+  b[ns1+ns2+1] = -1.0;
+  b[ns1+ns2+ni1+1] = -1.0;
+
+  SparseLTableau tab(columns, b);
+  eps = tab.Epsilon();
+
+  tab.Pivot(ns1+ns2+1, 0);
+  tab.SF_LCPPath(ns1+ns2+1);
+
+  Vector<double> sol(tab.MinRow(), tab.MaxRow());
+  tab.BasisVector(sol);
+  MixedBehavProfile<double> profile(p_support);
+  GetProfile(p_support, tab, profile, sol, p_support.GetGame()->GetRoot(), 1, 1);
+  UndefinedToCentroid(profile);
+
+  if (p_print) {
+    PrintProfile(std::cout, "NE", profile);
+    if (g_printDetail) {
+      PrintProfileDetail(std::cout, profile);
+    }
+  }
+  p_solutions.Append(profile);
+  return true;
+}
+
 template <class T> int SolveEfgLcp<T>::AddBFS(const LTableau<T> &tableau)
 {
   BFS<T> cbfs;
@@ -398,8 +522,8 @@ SolveEfgLcp<T>::AllLemke(const BehavSupport &p_support,
   return 1;
 }
 
-template <class T>
-void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
+template <class T> template <class M>
+void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, M &A,
 				 const GameNode &n, T prob,
 				 int s1, int s2, int i1, int i2)
 {
@@ -422,12 +546,8 @@ void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
     }
     int pl = n->GetPlayer()->GetNumber();
     if (pl==1) {
-      i1=isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(isets1[i]->GetPlayer()->GetNumber(),
-				   isets1[i]->GetNumber());
-      }
+      i1=isetno1[n->GetInfoset()->GetNumber()];
+      snew=seqno1[i1];
       A(s1,ns1+ns2+i1+1) = -(T)1;
       A(ns1+ns2+i1+1,s1) = (T)1;
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
@@ -437,12 +557,8 @@ void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
       }
     }
     if(pl==2) {
-      i2=isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(isets2[i]->GetPlayer()->GetNumber(),
-				   isets2[i]->GetNumber());
-      }
+      i2=isetno2[n->GetInfoset()->GetNumber()];
+      snew=seqno2[i2];
       A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
       A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
@@ -456,9 +572,9 @@ void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
 }
 
 
-template <class T>
+template <class T> template <class Tab>
 void SolveEfgLcp<T>::GetProfile(const BehavSupport &p_support,
-				const LTableau<T> &tab, 
+				const Tab &tab, 
 				MixedBehavProfile<T> &v, 
 				const Vector<T> &sol,
 				const GameNode &n, int s1,int s2)
@@ -473,11 +589,8 @@ void SolveEfgLcp<T>::GetProfile(const BehavSupport &p_support,
       }
     }
     else if (pl == 1) {
-      int inf = isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, isets1[i]->GetNumber()); 
-      }
+      int inf = isetno1[iset];
+      int snew = seqno1[inf];
       
       for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -498,11 +611,8 @@ void SolveEfgLcp<T>::GetProfile(const BehavSupport &p_support,
       }
     }
     else if (pl == 2) { 
-      int inf = isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, isets2[i]->GetNumber()); 
-      }
+      int inf = isetno2[iset];
+      int snew = seqno2[inf];
 
       for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
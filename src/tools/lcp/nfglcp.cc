@@ -23,6 +23,9 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <iostream>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "libgambit/libgambit.h"
 #include "lhtab.h"
@@ -118,22 +121,14 @@ template <class T> Vector<T> Make_b2(const StrategySupport &);
 
 
 //
-// Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
+// Function called when a new CBFS is encountered.
 // The corresponding equilibrium is computed and output.
-// Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// Returns 'false' if the CBFS is the trivial one, which is not output.
 //
 template <class T>
-bool OnBFS(const StrategySupport &p_support,
-	   List<BFS<T> > &p_list, LHTableau<T> &p_tableau)
+bool OnBFS(const StrategySupport &p_support, LHTableau<T> &p_tableau)
 {
   BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_list.Contains(cbfs)) {
-    return false;
-  }
-
-  p_list.Append(cbfs);
 
   MixedStrategyProfile<T> profile(p_support.NewMixedStrategyProfile<T>());
   int n1 = p_support.NumStrategies(1);
@@ -178,40 +173,95 @@ bool OnBFS(const StrategySupport &p_support,
     PrintProfileDetail(std::cout, profile);
   }
 
-  if (g_stopAfter > 0 && p_list.Length() >= g_stopAfter) {
-    throw EquilibriumLimitReachedNfg();
-  }
-
   return true;
 }
 
+//
+// A complementary basis visited by AllLemke, keyed by the labels of
+// its basic variables.  Lemke-Howson paths are reversible, so once a
+// path has been followed into a basis by dropping label i, following
+// label i out of that basis would only retrace it; m_labels holds the
+// labels which need not be followed from this basis for that reason,
+// or because they have already been followed.
+//
+class LemkeNode {
+public:
+  bool m_reached;
+  std::set<int> m_labels;
+
+  LemkeNode(void) : m_reached(false) { }
+};
+
+typedef std::map<std::vector<int>, LemkeNode> LemkeNodeMap;
+
+template <class T> std::vector<int> GetBasis(const LHTableau<T> &B)
+{
+  std::vector<int> basis;
+  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+    if (B.Member(i))  basis.push_back(i);
+  }
+  return basis;
+}
+
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
-// for the equilibria that have already been found.  
-// From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// calling itself.  p_nodes maintains the bases which have already
+// been visited, and p_count the number of those which have been
+// reached by a path.  From each new accessible equilibrium, it follows
+// all paths not already accounted for, outputting any new equilibria.
+// The tableau B is consumed: the last path from a basis is followed
+// on B itself, and only the others on copies.
 //
 template <class T> void AllLemke(const StrategySupport &p_support,
 				 int j, LHTableau<T> &B,
-				 List<BFS<T> > &p_list,
+				 LemkeNodeMap &p_nodes, int &p_count,
 				 int depth)
 {
   if (g_maxDepth != 0 && depth > g_maxDepth) {
     return;
   }
 
+  LemkeNode &node = p_nodes[GetBasis(B)];
+  if (j != 0) {
+    node.m_labels.insert(j);
+  }
+
   // On the initial depth=0 call, the CBFS we are at is the extraneous
   // solution.
-  if (depth > 0 && !OnBFS(p_support, p_list, B)) {
+  if (depth > 0) {
+    if (node.m_reached) {
+      return;
+    }
+    node.m_reached = true;
+    p_count++;
+    if (!OnBFS(p_support, B)) {
+      return;
+    }
+    if (g_stopAfter > 0 && p_count >= g_stopAfter) {
+      throw EquilibriumLimitReachedNfg();
+    }
+  }
+
+  if (g_maxDepth != 0 && depth + 1 > g_maxDepth) {
     return;
   }
   
   for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
-    if (i != j)  {
+    if (node.m_labels.count(i)) {
+      continue;
+    }
+    node.m_labels.insert(i);
+
+    int k = i + 1;
+    while (k <= B.MaxCol() && node.m_labels.count(k))  k++;
+    if (k > B.MaxCol()) {
+      B.LemkePath(i);
+      AllLemke(p_support, i, B, p_nodes, p_count, depth+1);
+    }
+    else {
       LHTableau<T> Bcopy(B);
       Bcopy.LemkePath(i);
-      AllLemke(p_support, i, Bcopy, p_list, depth+1);
+      AllLemke(p_support, i, Bcopy, p_nodes, p_count, depth+1);
     }
   }
 }
@@ -220,7 +270,8 @@ template <class T>
 void SolveStrategic(const Game &p_game)
 {
   StrategySupport support(p_game);
-  List<BFS<T> > bfsList;
+  LemkeNodeMap nodes;
+  int count = 0;
 
   try {
     Matrix<T> A1 = Make_A1<T>(support);
@@ -231,16 +282,16 @@ void SolveStrategic(const Game &p_game)
 
     if (g_stopAfter != 1) {
       try {
-	AllLemke(support, 0, B, bfsList, 0);
+	AllLemke(support, 0, B, nodes, count, 0);
       }
       catch (EquilibriumLimitReachedNfg &) {
 	// This pseudo-exception requires no additional action;
-	// bfsList will contain the list of equilibria found
+	// the equilibria found have already been output
       }
     }
     else  {
       B.LemkePath(1);
-      OnBFS(support, bfsList, B);
+      OnBFS(support, B);
     }
 
     return;
@@ -0,0 +1,341 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/lcp/sparsetab.cc
+// Implementation of sparse Lemke tableau class
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+//
+
+#include <math.h>
+#include <algorithm>
+#include "sparsetab.h"
+
+namespace {
+
+// Refactor after this many pivots since the last refactorization...
+const int c_maxEtas = 100;
+// ...or once the pivots have added this multiple of the nonzeros of
+// the fresh factorization
+const int c_maxFill = 2;
+
+class ColumnLengthLess {
+private:
+  const Gambit::Array<SparseColumn> &m_columns;
+public:
+  ColumnLengthLess(const Gambit::Array<SparseColumn> &p_columns)
+    : m_columns(p_columns) { }
+  bool operator()(int p_a, int p_b) const
+  { return m_columns[p_a].size() < m_columns[p_b].size(); }
+};
+
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------
+//                   Sparse Lemke Tableau: member functions
+//---------------------------------------------------------------------------
+
+SparseLTableau::SparseLTableau(const Gambit::Array<SparseColumn> &p_columns,
+			       const Gambit::Vector<double> &p_b)
+  : m_columns(p_columns), m_b(p_b),
+    m_label(p_b.Length()), m_row(-p_b.Length(), p_b.Length()),
+    m_eta(p_b.Length()), m_refactorEtas(0), m_refactorNonzeros(0),
+    m_solution(p_b), m_eps2(1.0e-8)
+{
+  for (int j = m_row.First(); j <= m_row.Last(); j++) {
+    m_row[j] = 0;
+  }
+  for (int i = 1; i <= m_label.Length(); i++) {
+    m_label[i] = -i;
+    m_row[-i] = i;
+  }
+}
+
+void SparseLTableau::SolveColumn(int p_label, Gambit::Vector<double> &p_column)
+{
+  p_column = 0.0;
+  if (p_label < 0) {
+    p_column[-p_label] = 1.0;
+  }
+  else {
+    const SparseColumn &column = m_columns[p_label];
+    for (size_t k = 0; k < column.size(); k++) {
+      p_column[column[k].first] = column[k].second;
+    }
+  }
+  m_eta.Solve(p_column);
+}
+
+void SparseLTableau::Pivot(int p_outrow, int p_inlabel)
+{
+  Gambit::Vector<double> column(MinRow(), MaxRow());
+  SolveColumn(p_inlabel, column);
+  m_eta.Append(p_outrow, column);
+
+  double ratio = m_solution[p_outrow] / column[p_outrow];
+  for (int i = MinRow(); i <= MaxRow(); i++) {
+    m_solution[i] -= column[i] * ratio;
+  }
+  m_solution[p_outrow] = ratio;
+
+  m_row[m_label[p_outrow]] = 0;
+  m_label[p_outrow] = p_inlabel;
+  m_row[p_inlabel] = p_outrow;
+
+  if (m_eta.NumEtas() - m_refactorEtas >= c_maxEtas ||
+      (m_eta.NumNonzeros() - m_refactorNonzeros > 
+       c_maxFill * m_refactorNonzeros + MaxRow())) {
+    Refactor();
+  }
+}
+
+//
+// Refactorization pivots the basic columns of A into the identity, in
+// order of increasing number of nonzeros, each into the row with the
+// largest entry among those rows whose slack is not basic.  Slacks
+// which are basic stay in their own rows.  The work is done on sparse
+// patterns, so its cost depends on the nonzeros of the basis and the
+// factorization only.
+//
+void SparseLTableau::Refactor(void)
+{
+  int n = MaxRow();
+  std::vector<int> columns;
+  Gambit::Array<bool> available(n);
+  for (int i = 1; i <= n; i++) {
+    available[i] = !Member(-i);
+    if (m_label[i] >= 0) {
+      columns.push_back(m_label[i]);
+    }
+  }
+  std::stable_sort(columns.begin(), columns.end(), 
+		   ColumnLengthLess(m_columns));
+
+  m_eta.Clear();
+  for (int i = 1; i <= n; i++) {
+    m_row[m_label[i]] = 0;
+  }
+  for (int i = 1; i <= n; i++) {
+    m_label[i] = -i;
+    m_row[-i] = i;
+  }
+
+  Gambit::Vector<double> work(n);
+  work = 0.0;
+  std::vector<int> pattern;
+  std::vector<char> mark(n + 1, 0);
+  for (size_t c = 0; c < columns.size(); c++) {
+    const SparseColumn &column = m_columns[columns[c]];
+    pattern.clear();
+    for (size_t k = 0; k < column.size(); k++) {
+      work[column[k].first] = column[k].second;
+      mark[column[k].first] = 1;
+      pattern.push_back(column[k].first);
+    }
+    m_eta.Solve(work, pattern, mark);
+
+    int pivot = 0;
+    for (size_t k = 0; k < pattern.size(); k++) {
+      int i = pattern[k];
+      if (available[i] && 
+	  (pivot == 0 || fabs(work[i]) > fabs(work[pivot]))) {
+	pivot = i;
+      }
+    }
+    if (pivot == 0 || fabs(work[pivot]) <= m_eps2) {
+      throw EtaFile::BadPivot();
+    }
+    m_eta.Append(pivot, work, pattern);
+    available[pivot] = false;
+    m_row[m_label[pivot]] = 0;
+    m_label[pivot] = columns[c];
+    m_row[columns[c]] = pivot;
+
+    for (size_t k = 0; k < pattern.size(); k++) {
+      work[pattern[k]] = 0.0;
+      mark[pattern[k]] = 0;
+    }
+  }
+
+  m_refactorEtas = m_eta.NumEtas();
+  m_refactorNonzeros = m_eta.NumNonzeros();
+  m_solution = m_b;
+  m_eta.Solve(m_solution);
+}
+
+//---------------------------------------------------------------------------
+//                 Sparse Lemke Tableau: Lemke path following
+//---------------------------------------------------------------------------
+
+//
+// These follow LTableau<T>::SF_PivotIn(), SF_ExitIndex() and SF_LCPPath(),
+// including the lexicographic resolution of degeneracy.
+//
+
+int SparseLTableau::SF_PivotIn(int inlabel)
+{ 
+  int outindex = SF_ExitIndex(inlabel);
+  if (outindex == 0) {
+    return inlabel;
+  }
+  int outlabel = Label(outindex);
+  Pivot(outindex, inlabel);
+  return outlabel;
+}
+
+int SparseLTableau::SF_ExitIndex(int inlabel)
+{
+  Gambit::Vector<double> incol(MinRow(), MaxRow());
+  SolveColumn(inlabel, incol);
+
+  // Find all row indices for which column col has positive entries.
+  std::vector<int> rows;
+  std::vector<char> alive(MaxRow() + 1, 0);
+  for (int i = MinRow(); i <= MaxRow(); i++) {
+    if (incol[i] > m_eps2) {
+      rows.push_back(i);
+      alive[i] = 1;
+    }
+  }
+  int remaining = rows.size();
+  if (remaining == 0) {
+    return 0;
+  }
+  RemoveNonminimizers(rows, m_solution, incol, alive, remaining);
+
+  // If there are multiple candidates, break ties lexicographically on
+  // the columns of the basis inverse, in order.  The column for row c
+  // is a unit vector when the slack for row c is basic, so it can only
+  // eliminate the row holding that slack, and needs no solve.  Other
+  // columns are solved for in turn, until that has cost as many solves
+  // as there are candidates left; it is then cheaper to compute their
+  // rows of the inverse instead, and to visit only the columns in which
+  // one of them is nonzero, as all ratios are zero elsewhere.
+  Gambit::Vector<double> col(MinRow(), MaxRow());
+  int c = MinRow(), solves = 0;
+  for (; remaining > 1 && remaining > solves; c++) {
+    if (c > MaxRow()) throw BadExitIndex();
+    if (Member(-c)) {
+      int row = Find(-c);
+      if (alive[row] && 1.0 / incol[row] > m_eps2) {
+	alive[row] = 0;
+	remaining--;
+      }
+    }
+    else {
+      SolveColumn(-c, col);
+      solves++;
+      RemoveNonminimizers(rows, col, incol, alive, remaining);
+    }
+  }
+  RemoveNonminimizers(rows, alive);
+
+  if (remaining > 1) {
+    std::vector<SparseColumn> inverse(rows.size());
+    std::vector<int> columns;
+    for (size_t k = 0; k < rows.size(); k++) {
+      col = 0.0;
+      col[rows[k]] = 1.0;
+      m_eta.SolveT(col);
+      for (int j = c; j <= MaxRow(); j++) {
+	if (col[j] != 0.0) {
+	  inverse[k].push_back(std::pair<int, double>(j, col[j] / incol[rows[k]]));
+	  columns.push_back(j);
+	}
+      }
+    }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+    std::vector<size_t> next(rows.size(), 0);
+    std::vector<double> ratios(rows.size());
+    for (size_t j = 0; j < columns.size() && remaining > 1; j++) {
+      double tempmax = 0.0;
+      bool first = true;
+      for (size_t k = 0; k < rows.size(); k++) {
+	ratios[k] = 0.0;
+	if (alive[rows[k]]) {
+	  const SparseColumn &entries = inverse[k];
+	  while (next[k] < entries.size() && entries[next[k]].first < columns[j]) {
+	    next[k]++;
+	  }
+	  if (next[k] < entries.size() && entries[next[k]].first == columns[j]) {
+	    ratios[k] = entries[next[k]].second;
+	  }
+	  if (first || ratios[k] < tempmax)  tempmax = ratios[k];
+	  first = false;
+	}
+      }
+      for (size_t k = 0; k < rows.size(); k++) {
+	if (alive[rows[k]] && ratios[k] > tempmax + m_eps2) {
+	  alive[rows[k]] = 0;
+	  remaining--;
+	}
+      }
+    }
+    RemoveNonminimizers(rows, alive);
+  }
+
+  if (remaining != 1) throw BadExitIndex();
+  return rows[0];
+}
+
+void SparseLTableau::RemoveNonminimizers(std::vector<int> &p_rows,
+					 const Gambit::Vector<double> &p_column,
+					 const Gambit::Vector<double> &p_incol,
+					 std::vector<char> &p_alive,
+					 int &p_remaining) const
+{
+  RemoveNonminimizers(p_rows, p_alive);
+  std::vector<double> ratios(p_rows.size());
+  double tempmax = 0.0;
+  for (size_t k = 0; k < p_rows.size(); k++) {
+    ratios[k] = p_column[p_rows[k]] / p_incol[p_rows[k]];
+    if (k == 0 || ratios[k] < tempmax)  tempmax = ratios[k];
+  }
+  for (size_t k = 0; k < p_rows.size(); k++) {
+    if (ratios[k] > tempmax + m_eps2) {
+      p_alive[p_rows[k]] = 0;
+      p_remaining--;
+    }
+  }
+}
+
+void SparseLTableau::RemoveNonminimizers(std::vector<int> &p_rows,
+					 const std::vector<char> &p_alive) const
+{
+  size_t m = 0;
+  for (size_t k = 0; k < p_rows.size(); k++) {
+    if (p_alive[p_rows[k]]) {
+      p_rows[m++] = p_rows[k];
+    }
+  }
+  p_rows.resize(m);
+}
+
+int SparseLTableau::SF_LCPPath(int dup)
+{
+  int enter = dup, exit;
+  do {
+    exit = SF_PivotIn(enter);
+    if (exit == enter) {
+      return 0;
+    }
+    enter = -exit;
+  } while (exit != 0);
+  return 1;
+}
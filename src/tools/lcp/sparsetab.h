@@ -0,0 +1,81 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/lcp/sparsetab.h
+// Declaration of sparse Lemke tableau class
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSETAB_H
+#define SPARSETAB_H
+
+#include "liblinear/etafile.h"
+
+//
+// A Lemke tableau for the system [I A] (w, z) = b, with A (columns
+// 0 through n) stored by sparse columns, and the basis inverse held as
+// an EtaFile which is periodically refactored.  Labels follow the
+// conventions of LTableau: column j of A has label j, and the slack
+// variable for row i has label -i.
+//
+// Only floating-point arithmetic is supported; this is used for
+// sequence-form problems which are too large to store densely.
+//
+class SparseLTableau {
+public:
+  class BadExitIndex : public Gambit::Exception  {
+  public:
+    virtual ~BadExitIndex() throw() { }
+    const char *what(void) const throw() { return "Bad Exit Index in SparseLTableau"; }
+  };
+
+  SparseLTableau(const Gambit::Array<SparseColumn> &p_columns,
+		 const Gambit::Vector<double> &p_b);
+
+  int MinRow(void) const { return 1; }
+  int MaxRow(void) const { return m_label.Length(); }
+  bool Member(int p_label) const { return (m_row[p_label] != 0); }
+  int Find(int p_label) const { return m_row[p_label]; }
+  int Label(int p_row) const { return m_label[p_row]; }
+  double Epsilon(void) const { return m_eps2; }
+
+  void Pivot(int p_outrow, int p_inlabel);
+  void SolveColumn(int p_label, Gambit::Vector<double> &p_column);
+  void BasisVector(Gambit::Vector<double> &p_x) const { p_x = m_solution; }
+  void Refactor(void);
+
+  int SF_PivotIn(int i);
+  int SF_ExitIndex(int i);
+  int SF_LCPPath(int dup); // follow a path of ACBFS's from one CBFS to another
+
+private:
+  void RemoveNonminimizers(std::vector<int> &,
+			   const Gambit::Vector<double> &,
+			   const Gambit::Vector<double> &,
+			   std::vector<char> &, int &) const;
+  void RemoveNonminimizers(std::vector<int> &, const std::vector<char> &) const;
+
+  const Gambit::Array<SparseColumn> &m_columns;
+  const Gambit::Vector<double> &m_b;
+  Gambit::Array<int> m_label, m_row;
+  EtaFile m_eta;
+  int m_refactorEtas, m_refactorNonzeros;
+  Gambit::Vector<double> m_solution;
+  double m_eps2;
+};
+
+#endif  // SPARSETAB_H
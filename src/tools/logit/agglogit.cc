@@ -0,0 +1,224 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/logit/agglogit.cc
+// Computation of symmetric quantal response equilibrium correspondence
+// for action-graph games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <math.h>
+#include <iostream>
+#include <algorithm>
+
+#include <libgambit/libgambit.h>
+using namespace Gambit;
+
+#include "agglogit.h"
+
+//----------------------------------------------------------------------------
+//               SymmetricQREPathTracer: Lifecycle and wrapper
+//----------------------------------------------------------------------------
+
+SymmetricQREPathTracer::SymmetricQREPathTracer(const Game &p_game)
+  : m_agg(dynamic_cast<GameAggRep &>(*p_game).GetUnderlyingAGG()),
+    m_classStrategy(m_agg->getNumActions()),
+    m_fullGraph(true), m_decimals(6)
+{
+  SetTargetParam(-1.0);
+
+  // The class strategies are the nodes of the class's action set in
+  // increasing order; players may list the same nodes in any order.
+  for (int cls = 0; cls < m_agg->getNumPlayerClasses(); cls++) {
+    const std::vector<int> &players = m_agg->getPlayerClass(cls);
+    for (size_t i = 0; i < players.size(); i++) {
+      const std::vector<int> &actions = m_agg->getActionSet(players[i]);
+      std::vector<int> nodes(actions);
+      std::sort(nodes.begin(), nodes.end());
+      for (size_t j = 0; j < actions.size(); j++) {
+	int rank = std::lower_bound(nodes.begin(), nodes.end(), 
+				    actions[j]) - nodes.begin();
+	m_classStrategy[m_agg->firstAction(players[i]) + j + 1] =
+	  m_agg->firstKSymAction(cls) + rank + 1;
+      }
+    }
+  }
+}
+
+void 
+SymmetricQREPathTracer::TraceSymmetricPath(double p_startLambda,
+					   double p_maxLambda, double p_omega)
+{
+  Vector<double> x(m_agg->getNumKSymActions() + 1);
+  for (int cls = 0; cls < m_agg->getNumPlayerClasses(); cls++) {
+    for (int a = m_agg->firstKSymAction(cls); 
+	 a < m_agg->lastKSymAction(cls); a++) {
+      x[a+1] = -log((double) m_agg->getNumKSymActions(cls));
+    }
+  }
+  x[x.Length()] = p_startLambda;
+
+  TracePath(x, p_maxLambda, p_omega);
+}
+
+//----------------------------------------------------------------------------
+//             SymmetricQREPathTracer: Providing virtual functions
+//----------------------------------------------------------------------------
+
+double
+SymmetricQREPathTracer::Criterion(const Vector<double> &p_point,
+				  const Vector<double> &p_tangent)
+{
+  if (GetTargetParam() > 0.0) {
+    return p_point[p_point.Length()] - GetTargetParam();
+  }
+  else {
+    return PathTracer::Criterion(p_point, p_tangent);
+  }
+}
+
+void 
+SymmetricQREPathTracer::GetLHS(const Vector<double> &p_point,
+			       Vector<double> &p_lhs)
+{
+  StrategyProfile profile(m_agg->getNumKSymActions());
+  for (int i = 0; i < m_agg->getNumKSymActions(); i++) {
+    profile[i] = exp(p_point[i+1]);
+  }
+  double lambda = p_point[p_point.Length()];
+
+  p_lhs = 0.0;
+
+  for (int cls = 0; cls < m_agg->getNumPlayerClasses(); cls++) {
+    int offset = m_agg->firstKSymAction(cls);
+    NumberVector values(m_agg->getNumKSymActions(cls));
+    m_agg->getKSymPayoffVector(values, cls, profile);
+
+    // sum-to-one equation
+    p_lhs[offset+1] = -1.0;
+    for (int a = 0; a < m_agg->getNumKSymActions(cls); a++) {
+      p_lhs[offset+1] += profile[offset+a];
+    }
+
+    // ratio equations
+    for (int a = 1; a < m_agg->getNumKSymActions(cls); a++) {
+      p_lhs[offset+a+1] = (p_point[offset+a+1] - p_point[offset+1] -
+			   lambda * (values[a] - values[0]));
+    }
+  }
+}
+
+void
+SymmetricQREPathTracer::GetJacobian(const Vector<double> &p_point,
+				    Matrix<double> &p_matrix)
+{
+  StrategyProfile profile(m_agg->getNumKSymActions());
+  for (int i = 0; i < m_agg->getNumKSymActions(); i++) {
+    profile[i] = exp(p_point[i+1]);
+  }
+  double lambda = p_point[p_point.Length()];
+
+  p_matrix = 0.0;
+
+  // The derivative of a class's payoff with respect to the strategy of
+  // class 'cls2' collects one term for each member of 'cls2' other than
+  // the deviating player; in particular, unlike the nonsymmetric case, a
+  // class's own strategy enters its payoffs through the other members
+  // of the class.
+  Vector<double> base(m_agg->getNumKSymActions());
+
+  for (int cls = 0; cls < m_agg->getNumPlayerClasses(); cls++) {
+    int offset = m_agg->firstKSymAction(cls);
+    NumberVector values(m_agg->getNumKSymActions(cls));
+    m_agg->getKSymPayoffVector(values, cls, profile);
+
+    // sum-to-one equation; derivative wrt lambda is zero
+    for (int a = 0; a < m_agg->getNumKSymActions(cls); a++) {
+      p_matrix(offset+a+1, offset+1) = profile[offset+a];
+    }
+
+    for (int cls2 = 0; cls2 < m_agg->getNumPlayerClasses(); cls2++) {
+      for (int b = m_agg->firstKSymAction(cls2); 
+	   b < m_agg->lastKSymAction(cls2); b++) {
+	base[b+1] = 
+	  m_agg->getKSymMixedPayoff(profile, cls, 0,
+				    cls2, b - m_agg->firstKSymAction(cls2));
+      }
+    }
+
+    // ratio equations
+    for (int a = 1; a < m_agg->getNumKSymActions(cls); a++) {
+      int rowno = offset + a + 1;
+      p_matrix(offset+1, rowno) = -1.0;
+      p_matrix(rowno, rowno) = 1.0;
+
+      for (int cls2 = 0; cls2 < m_agg->getNumPlayerClasses(); cls2++) {
+	int others = (m_agg->getPlayerClass(cls2).size() - 
+		      ((cls == cls2) ? 1 : 0));
+	if (others == 0) {
+	  continue;
+	}
+	for (int b = m_agg->firstKSymAction(cls2); 
+	     b < m_agg->lastKSymAction(cls2); b++) {
+	  p_matrix(b+1, rowno) -=
+	    lambda * others * profile[b] *
+	    (m_agg->getKSymMixedPayoff(profile, cls, a,
+				       cls2, b - m_agg->firstKSymAction(cls2)) -
+	     base[b+1]);
+	}
+      }
+
+      // column wrt lambda
+      p_matrix(p_matrix.NumRows(), rowno) = values[0] - values[a];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+//                SymmetricQREPathTracer: Outputting profiles
+//----------------------------------------------------------------------------
+
+void 
+SymmetricQREPathTracer::PrintProfile(std::ostream &p_stream,
+				     const Vector<double> &x,
+				     bool p_isTerminal)
+{
+  p_stream.setf(std::ios::fixed);
+  // By convention, we output lambda first
+  if (!p_isTerminal) {
+    p_stream << std::setprecision(m_decimals) << x[x.Length()];
+  }
+  else {
+    p_stream << "NE";
+  }
+  p_stream.unsetf(std::ios::fixed);
+
+  for (int i = 1; i <= m_classStrategy.Length(); i++) {
+    p_stream << "," << std::setprecision(m_decimals) 
+	     << exp(x[m_classStrategy[i]]);
+  }
+
+  p_stream << std::endl;
+}
+
+void 
+SymmetricQREPathTracer::OnStep(const Vector<double> &x, bool p_isTerminal)
+{
+  if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
+    PrintProfile(std::cout, x, p_isTerminal);
+  }
+}
@@ -0,0 +1,76 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2010, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/logit/agglogit.h
+// Computation of symmetric quantal response equilibrium correspondence
+// for action-graph games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef AGGLOGIT_H
+#define AGGLOGIT_H
+
+#include "path.h"
+
+//
+// Traces the principal branch of the logit correspondence of an
+// action-graph game in the space of k-symmetric profiles, in which all
+// players sharing an action set (a "player class") play the same mixed
+// strategy.  The centroid is k-symmetric, and the QRE equations are
+// invariant under permutations of players within a class, so the
+// principal branch stays in this space; the system to be solved has one
+// block of equations per class rather than one per player.
+//
+// Profiles are expanded back to one mixed strategy per player on output,
+// so the output has the same layout as that of StrategicQREPathTracer.
+//
+class SymmetricQREPathTracer : public PathTracer {
+public:
+  SymmetricQREPathTracer(const Game &p_game);
+  virtual ~SymmetricQREPathTracer() { }
+
+  void TraceSymmetricPath(double p_startLambda, double p_maxLambda, 
+			  double p_omega);
+
+  void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
+  bool GetFullGraph(void) const { return m_fullGraph; }
+
+  void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
+  int GetDecimals(void) const { return m_decimals; }
+
+protected:
+  virtual void OnStep(const Vector<double> &, bool);
+
+  virtual double Criterion(const Vector<double> &, const Vector<double> &);
+
+  // Compute the LHS of the system of equations at the specified point.
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs);
+  // Compute the Jacobian matrix at the specified point.
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
+
+private:
+  void PrintProfile(std::ostream &, const Vector<double> &, bool);
+
+  agg *m_agg;
+  // For each strategy in the full profile, the index of the
+  // corresponding class strategy in the point vector
+  Array<int> m_classStrategy;
+  bool m_fullGraph;
+  int m_decimals;
+};
+
+#endif // AGGLOGIT_H
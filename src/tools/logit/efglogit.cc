@@ -82,30 +82,27 @@ double SumToOneEquation::Value(const LogBehavProfile<double> &p_profile,
   return value;
 }
 
+//
+// Only the entries for the actions at the information set are written;
+// the caller is responsible for zeroing the rest of the gradient.
+//
 void SumToOneEquation::Gradient(const LogBehavProfile<double> &p_profile,
 				double p_lambda,
 				Vector<double> &p_gradient)
 {
   int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
-
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
-
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (pl == m_pl && iset == m_iset) {
-	  p_gradient[i] = p_profile.GetProb(pl, iset, act);
-	}
-	else {
-	  p_gradient[i] = 0.0;
-	}
-      }
+  for (int pl = 1; pl < m_pl; pl++) {
+    for (int iset = 1; iset <= m_game->GetPlayer(pl)->NumInfosets(); iset++) {
+      i += m_game->GetPlayer(pl)->GetInfoset(iset)->NumActions();
     }
   }
+  for (int iset = 1; iset < m_iset; iset++) {
+    i += m_game->GetPlayer(m_pl)->GetInfoset(iset)->NumActions();
+  }
 
-  // Derivative wrt lambda is zero
-  p_gradient[i] = 0.0;
+  for (int act = 1; act <= m_infoset->NumActions(); act++, i++) {
+    p_gradient[i] = p_profile.GetProb(m_pl, m_iset, act);
+  }
 }
 			       
 
@@ -119,11 +116,13 @@ private:
   Game m_game;
   int m_pl, m_iset, m_act;
   GameInfoset m_infoset;
+  DVector<double> m_derivs;
 
 public:
   RatioEquation(Game p_game, int p_player, int p_infoset, int p_action)
     : m_game(p_game), m_pl(p_player), m_iset(p_infoset), m_act(p_action),
-      m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset))
+      m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset)),
+      m_derivs(p_game->NumActions())
   { }
 
   double Value(const LogBehavProfile<double> &p_profile, 
@@ -147,37 +146,28 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 			     double p_lambda,
 			     Vector<double> &p_gradient)
 {
-  int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (infoset == m_infoset) {
-	  if (act == 1) {
-	    p_gradient[i] = -1.0;
-	  }
-	  else if (act == m_act) {
-	    p_gradient[i] = 1.0; 
-	  }
-	  else {
-	    p_gradient[i] = 0.0;
-	  }
-	}
-	else {   // infoset1 != infoset2
-	  p_gradient[i] = 
-	    -p_lambda * 
-	    (p_profile.DiffActionValue(m_infoset->GetAction(m_act),
-				       infoset->GetAction(act)) -
-	     p_profile.DiffActionValue(m_infoset->GetAction(1),
-				       infoset->GetAction(act)));
-	}
-      }
+  m_derivs = 0.0;
+  p_profile.DiffActionValues(m_infoset->GetAction(m_act), -p_lambda, m_derivs);
+  p_profile.DiffActionValues(m_infoset->GetAction(1), p_lambda, m_derivs);
+
+  for (int act = 1; act <= m_infoset->NumActions(); act++) {
+    if (act == 1) {
+      m_derivs(m_pl, m_iset, act) = -1.0;
+    }
+    else if (act == m_act) {
+      m_derivs(m_pl, m_iset, act) = 1.0;
+    }
+    else {
+      m_derivs(m_pl, m_iset, act) = 0.0;
     }
   }
 
-  p_gradient[i] = (p_profile.GetActionValue(m_infoset->GetAction(1)) -
-		   p_profile.GetActionValue(m_infoset->GetAction(m_act)));
+  for (int i = 1; i <= m_derivs.Length(); i++) {
+    p_gradient[i] = m_derivs[i];
+  }
+  p_gradient[m_derivs.Length() + 1] = 
+    (p_profile.GetActionValue(m_infoset->GetAction(1)) -
+     p_profile.GetActionValue(m_infoset->GetAction(m_act)));
 }
 
 
@@ -268,8 +258,9 @@ AgentQREPathTracer::GetJacobian(const Vector<double> &p_point,
   }
   double lambda = p_point[p_point.Length()];
 
+  Vector<double> column(p_point.Length());
   for (int i = 1; i <= m_equations.Length(); i++) {
-    Vector<double> column(p_point.Length());
+    column = 0.0;
     m_equations[i]->Gradient(profile, lambda, column);
     p_matrix.SetColumn(i, column);
   }
@@ -80,6 +80,7 @@ protected:
   /// @name Auxiliary functions for computation of interesting values
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
+  void DiffNodeValues(const GameNode &, int, const T &, DVector<T> &) const;
   
   void ComputeSolutionDataPass2(const GameNode &node) const;
   void ComputeSolutionDataPass1(const GameNode &node) const;
@@ -195,6 +196,11 @@ public:
 		   const GameAction &oppAction) const;
   T DiffNodeValue(const GameNode &node, const GamePlayer &player,
 		  const GameAction &oppAction) const;
+  /// Adds p_coeff times the derivatives of the value of 'action' with
+  /// respect to each action outside its information set to 'p_derivs',
+  /// computing all of them in a single sweep of the tree
+  void DiffActionValues(const GameAction &action, const T &p_coeff,
+			DVector<T> &p_derivs) const;
 
   //@}
 };
@@ -28,6 +28,7 @@
 #include "libgambit/libgambit.h"
 #include "efglogit.h"
 #include "nfglogit.h"
+#include "agglogit.h"
 
 
 void PrintBanner(std::ostream &p_stream)
@@ -52,6 +53,12 @@ void PrintHelp(char *progname)
   std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
+  std::cerr << "  -k               for action-graph games, trace the branch in the\n";
+  std::cerr << "                   space of profiles in which players with the\n";
+  std::cerr << "                   same action set play the same strategy\n";
+  std::cerr << "  -c FILE          periodically save the state of the trace to FILE\n";
+  std::cerr << "  -C SECONDS       save the state at most every SECONDS (default is 60)\n";
+  std::cerr << "  -r FILE          resume the trace from the state saved in FILE\n";
   std::cerr << "  -h               print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
@@ -86,7 +93,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, useSymmetric = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "", startFile = "";
   double maxDecel = 1.1;
@@ -94,9 +101,11 @@ int main(int argc, char *argv[])
   double targetLambda = -1.0;
   bool fullGraph = true;
   int decimals = 6;
+  std::string checkpointFile = "", resumeFile = "";
+  int checkpointInterval = 60;
 
   int c;
-  while ((c = getopt(argc, argv, "d:s:a:m:qehSL:p:l:")) != -1) {
+  while ((c = getopt(argc, argv, "d:s:a:m:qehSkL:p:l:c:C:r:")) != -1) {
     switch (c) {
     case 'q':
       quiet = true;
@@ -122,6 +131,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'k':
+      useSymmetric = true;
+      break;
     case 'L':
       mleFile = optarg;
       break;
@@ -131,6 +143,15 @@ int main(int argc, char *argv[])
     case 'l':
       targetLambda = atof(optarg);
       break;
+    case 'c':
+      checkpointFile = optarg;
+      break;
+    case 'C':
+      checkpointInterval = atoi(optarg);
+      break;
+    case 'r':
+      resumeFile = optarg;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -152,6 +173,23 @@ int main(int argc, char *argv[])
     Gambit::Array<double> frequencies;
     Gambit::Game game = Gambit::ReadGame(std::cin);
 
+    if (useSymmetric) {
+      if (!dynamic_cast<Gambit::GameAggRep *>(game.operator->())) {
+	std::cerr << "Error: Symmetric tracing requires an action-graph game.\n";
+	return 1;
+      }
+      SymmetricQREPathTracer tracer(game);
+      tracer.SetMaxDecel(maxDecel);
+      tracer.SetStepsize(hStart);
+      tracer.SetFullGraph(fullGraph);
+      tracer.SetTargetParam(targetLambda);
+      tracer.SetDecimals(decimals);
+      tracer.SetCheckpoint(checkpointFile, checkpointInterval);
+      tracer.SetResume(resumeFile);
+      tracer.TraceSymmetricPath(0.0, maxLambda, 1.0);
+      return 0;
+    }
+
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
       frequencies = Gambit::Array<double>(game->MixedProfileLength());
       std::ifstream mleData(mleFile.c_str());
@@ -171,6 +209,8 @@ int main(int argc, char *argv[])
 	tracer.SetTargetParam(targetLambda);
 	tracer.SetDecimals(decimals);
 	tracer.SetMLEFrequencies(frequencies);
+	tracer.SetCheckpoint(checkpointFile, checkpointInterval);
+	tracer.SetResume(resumeFile);
 	tracer.TraceStrategicPath(start, 0.0, maxLambda, 1.0);
       }
       else {
@@ -207,10 +247,16 @@ int main(int argc, char *argv[])
       tracer.SetFullGraph(fullGraph);
       tracer.SetTargetParam(targetLambda);
       tracer.SetDecimals(decimals);
+      tracer.SetCheckpoint(checkpointFile, checkpointInterval);
+      tracer.SetResume(resumeFile);
       tracer.TraceAgentPath(start, 0.0, maxLambda, 1.0);
     }
     return 0;
   }
+  catch (CheckpointException &) {
+    std::cerr << "Error: Checkpoint file is unreadable or does not match the game.\n";
+    return 1;
+  }
   catch (Gambit::InvalidFileException) {
     std::cerr << "Error: Game not in a recognized format.\n";
     return 1;
@@ -23,9 +23,11 @@
 #include <math.h>
 #include <algorithm>   // for std::max
 #include <iostream>
+#include <fstream>
+#include <cstdio>      // for rename
+#include <ctime>
 
 #include <libgambit/libgambit.h>
-#include <libgambit/sqmatrix.h>
 using namespace Gambit;
 
 #include "path.h"
@@ -36,10 +38,18 @@ using namespace Gambit;
 
 inline double sqr(double x) { return x*x; }
 
-static void Givens(Matrix<double> &b, Matrix<double> &q,
-		   double &c1, double &c2, int l1, int l2, int l3)
+//
+// The Jacobian b, with one column per equation, is factored as q b = R
+// using Givens rotations.  Rather than accumulating q, the rotation
+// which eliminates entry (k, m) is recorded in place: its sine in b(k, m)
+// and its cosine in c(k, m).  q is then applied to vectors as needed.
+// The rows of b are stored contiguously, so rotations run along rows.
+//
+static void Givens(Matrix<double> &b, Matrix<double> &c, int l1, int l2)
 {
+  double &c1 = b(l1, l1), &c2 = b(l2, l1);
   if (fabs(c1) + fabs(c2) == 0.0) {
+    c(l2, l1) = 1.0;
     return;
   }
 
@@ -53,37 +63,59 @@ static void Givens(Matrix<double> &b, Matrix<double> &q,
   double s1 = c1/sn;
   double s2 = c2/sn;
 
-  for (int k = 1; k <= q.NumColumns(); k++) {
-    double sv1 = q(l1, k);
-    double sv2 = q(l2, k);
-    q(l1, k) = s1 * sv1 + s2 * sv2;
-    q(l2, k) = -s2 * sv1 + s1 * sv2;
-  }
-
-  for (int k = l3; k <= b.NumColumns(); k++) {
-    double sv1 = b(l1, k);
-    double sv2 = b(l2, k);
-    b(l1, k) = s1 * sv1 + s2 * sv2;
-    b(l2, k) = -s2 * sv1 + s1 * sv2;
+  double *row1 = &b(l1, 1) - 1, *row2 = &b(l2, 1) - 1;
+  for (int k = l1 + 1; k <= b.NumColumns(); k++) {
+    double sv1 = row1[k];
+    double sv2 = row2[k];
+    row1[k] = s1 * sv1 + s2 * sv2;
+    row2[k] = -s2 * sv1 + s1 * sv2;
   }
 
   c1 = sn;
-  c2 = 0.0;
+  c2 = s2;
+  c(l2, l1) = s1;
 }
 
-static void QRDecomp(Matrix<double> &b, Matrix<double> &q)
+static void QRDecomp(Matrix<double> &b, Matrix<double> &c)
 {
-  q.MakeIdent();
   for (int m = 1; m <= b.NumColumns(); m++) {
     for (int k = m + 1; k <= b.NumRows(); k++) {
-      Givens(b, q, b(m, m), b(k, m), m, k, m + 1);
+      Givens(b, c, m, k);
     }
   }
 }
 
-static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
-		       Vector<double> &u, Vector<double> &y,
-		       double &d)
+//
+// Overwrites x with the transpose of q times x
+//
+static void ApplyTransposeQ(const Matrix<double> &b, const Matrix<double> &c,
+			    Vector<double> &x)
+{
+  for (int m = b.NumColumns(); m >= 1; m--) {
+    for (int k = b.NumRows(); k > m; k--) {
+      double s1 = c(k, m), s2 = b(k, m);
+      double sv1 = x[m];
+      double sv2 = x[k];
+      x[m] = s1 * sv1 - s2 * sv2;
+      x[k] = s2 * sv1 + s1 * sv2;
+    }
+  }
+}
+
+//
+// The tangent to the curve is the last row of q
+//
+static void Tangent(const Matrix<double> &b, const Matrix<double> &c,
+		    Vector<double> &t)
+{
+  t = 0.0;
+  t[t.Length()] = 1.0;
+  ApplyTransposeQ(b, c, t);
+}
+
+static void NewtonStep(const Matrix<double> &b, const Matrix<double> &c,
+		       Vector<double> &u, Vector<double> &y, 
+		       Vector<double> &s, double &d)
 {
   for (int k = 1; k <= b.NumColumns(); k++) {
     for (int l = 1; l <= k - 1; l++) {
@@ -92,18 +124,77 @@ static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
     y[k] /= b(k, k);
   }
 
-  d = 0.0;
-  for (int k = 1; k <= b.NumRows(); k++) {
-    double s = 0.0;
-    for (int l = 1; l <= b.NumColumns(); l++) {
-      s += q(l, k) * y[l];
-    }
-    u[k] -= s;
-    d += s * s;
+  for (int k = 1; k <= b.NumColumns(); k++) {
+    s[k] = y[k];
+  }
+  s[s.Length()] = 0.0;
+  ApplyTransposeQ(b, c, s);
+
+  u -= s;
+  d = sqrt(s.NormSquared());
+}
+
+
+//----------------------------------------------------------------------------
+//                       PathTracer: Checkpointing
+//----------------------------------------------------------------------------
+
+//
+// A checkpoint holds the point, the tangent at the point, the stepsize,
+// and the orientation of the trace, as raw binary data in the native
+// byte order.  It is written to a temporary file which then replaces the
+// checkpoint, so that an interrupted write never leaves a corrupt file.
+//
+static const char c_checkpointMagic[8] = { 'G', 'B', 'T', 'P', 'A', 'T', 'H', '1' };
+
+void PathTracer::WriteCheckpoint(const Vector<double> &p_x, 
+				 const Vector<double> &p_t,
+				 double p_h, double p_omega) const
+{
+  std::string tmpFile = m_checkpointFile + ".tmp";
+  std::ofstream f(tmpFile.c_str(), std::ios::out | std::ios::binary);
+  int n = p_x.Length();
+  f.write(c_checkpointMagic, sizeof(c_checkpointMagic));
+  f.write((const char *) &n, sizeof(int));
+  for (int i = 1; i <= n; i++) {
+    f.write((const char *) &p_x[i], sizeof(double));
+  }
+  for (int i = 1; i <= n; i++) {
+    f.write((const char *) &p_t[i], sizeof(double));
+  }
+  f.write((const char *) &p_h, sizeof(double));
+  f.write((const char *) &p_omega, sizeof(double));
+  f.close();
+  if (f.good()) {
+    rename(tmpFile.c_str(), m_checkpointFile.c_str());
   }
-  d = sqrt(d);
 }
 
+void PathTracer::ReadCheckpoint(Vector<double> &p_x, Vector<double> &p_t,
+				double &p_h, double &p_omega) const
+{
+  std::ifstream f(m_resumeFile.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(c_checkpointMagic)];
+  int n;
+  f.read(magic, sizeof(magic));
+  f.read((char *) &n, sizeof(int));
+  if (!f.good() || 
+      !std::equal(magic, magic + sizeof(magic), c_checkpointMagic) ||
+      n != p_x.Length()) {
+    throw CheckpointException();
+  }
+  for (int i = 1; i <= n; i++) {
+    f.read((char *) &p_x[i], sizeof(double));
+  }
+  for (int i = 1; i <= n; i++) {
+    f.read((char *) &p_t[i], sizeof(double));
+  }
+  f.read((char *) &p_h, sizeof(double));
+  f.read((char *) &p_omega, sizeof(double));
+  if (!f.good()) {
+    throw CheckpointException();
+  }
+}
 
 //----------------------------------------------------------------------------
 //             PathTracer: Implementation of path-following engine
@@ -127,14 +218,22 @@ PathTracer::TracePath(Vector<double> &x,
   Vector<double> u(x.Length()), restart(x.Length());
   // t is current tangent at x; newT is tangent at u, which is the next point.
   Vector<double> t(x.Length()), newT(x.Length());
-  Vector<double> y(x.Length() - 1);
-  Matrix<double> b(x.Length(), x.Length() - 1);
-  SquareMatrix<double> q(x.Length());
-
-  OnStep(x, false);
-  GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  Vector<double> y(x.Length() - 1), s(x.Length());
+  Matrix<double> b(x.Length(), x.Length() - 1), c(x.Length(), x.Length() - 1);
+
+  if (m_resumeFile != "") {
+    // The resumed point was already reported by the interrupted trace.
+    // Only the first trace after SetResume() is resumed.
+    ReadCheckpoint(x, t, h, p_omega);
+    m_resumeFile = "";
+  }
+  else {
+    OnStep(x, false);
+    GetJacobian(x, b);
+    QRDecomp(b, c);
+    Tangent(b, c, t);
+  }
+  time_t lastCheckpoint = time(0);
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -148,13 +247,11 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     // Predictor step
-    for (int k = 1; k <= x.Length(); k++) {
-      u[k] = x[k] + h * p_omega * t[k];
-    }
+    u.SetAxpy(x, h * p_omega, t);
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
     GetJacobian(u, b);
-    QRDecomp(b, q);
+    QRDecomp(b, c);
 
     int iter = 1;
     double disto = 0.0;
@@ -162,7 +259,7 @@ PathTracer::TracePath(Vector<double> &x,
       double dist;
 
       GetLHS(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      NewtonStep(b, c, u, y, s, dist); 
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -215,7 +312,7 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    Tangent(b, c, newT); 
 
     if (!newton &&
 	Criterion(x, t) * Criterion(u, newT) < 0.0) {
@@ -243,8 +340,17 @@ PathTracer::TracePath(Vector<double> &x,
       p_omega = -p_omega;
     }
     t = newT;
+
+    if (m_checkpointFile != "" && !newton &&
+	difftime(time(0), lastCheckpoint) >= m_checkpointInterval) {
+      WriteCheckpoint(x, t, h, p_omega);
+      lastCheckpoint = time(0);
+    }
   }
 
+  if (m_checkpointFile != "" && !newton) {
+    WriteCheckpoint(x, t, h, p_omega);
+  }
   OnStep(x, true);
   if (newton) {
     x = restart;
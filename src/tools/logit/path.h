@@ -25,6 +25,14 @@
 
 using namespace Gambit;
 
+/// Exception thrown when a checkpoint cannot be read or restored
+class CheckpointException : public Exception {
+public:
+  virtual ~CheckpointException() throw() { }
+  const char *what(void) const throw() 
+  { return "Checkpoint file is unreadable or does not match the game"; }
+};
+
 //
 // This class implements a generic path-following algorithm for smooth curves.
 // It is based on the ideas and codes presented in Allgower and Georg's
@@ -41,8 +49,20 @@ public:
   void SetTargetParam(double p_targetParam) { m_targetParam = p_targetParam; }
   double GetTargetParam(void) const { return m_targetParam; }
 
+  // Periodically save the state of the tracer to a file, at most once
+  // every p_interval seconds, and whenever the end of the path is reached
+  void SetCheckpoint(const std::string &p_file, int p_interval)
+    { m_checkpointFile = p_file;  m_checkpointInterval = p_interval; }
+  const std::string &GetCheckpoint(void) const { return m_checkpointFile; }
+
+  // Continue the next trace from the state saved in a checkpoint file,
+  // instead of from the starting point passed to TracePath()
+  void SetResume(const std::string &p_file) { m_resumeFile = p_file; }
+  const std::string &GetResume(void) const { return m_resumeFile; }
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0) 
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0),
+		     m_checkpointInterval(60)
     { } 
   virtual ~PathTracer() { }
 
@@ -61,7 +81,14 @@ protected:
   virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix) = 0;
 
 private:
+  void WriteCheckpoint(const Vector<double> &p_x, const Vector<double> &p_t,
+		       double p_h, double p_omega) const;
+  void ReadCheckpoint(Vector<double> &p_x, Vector<double> &p_t,
+		      double &p_h, double &p_omega) const;
+
   double m_maxDecel, m_hStart, m_targetParam;
+  std::string m_checkpointFile, m_resumeFile;
+  int m_checkpointInterval;
 };
 
 #endif  // PATH_H
@@ -25,6 +25,7 @@
 #include <iostream>
 #include "libgambit/libgambit.h"
 #include "liblinear/lpsolve.h"
+#include "liblinear/sparselp.h"
 
 using namespace Gambit;
 
@@ -195,6 +196,29 @@ SolveLP(const Matrix<T> &A, const Vector<T> &b, const Vector<T> &c,
   }
 }
 
+//
+// In floating point, the problem is instead solved by the revised
+// simplex method on the sparse columns of A, which scales to much
+// larger games.
+//
+static bool
+SolveLP(const Matrix<double> &A, const Vector<double> &b,
+	const Vector<double> &c, int nequals,
+	Array<double> &p_primal, Array<double> &p_dual)
+{
+  SparseLPSolve LP(A, b, c, nequals);
+  if (!LP.IsFeasible() || !LP.IsBounded()) {
+    return false;
+  }
+  for (int i = 1; i <= A.NumColumns(); i++) {
+    p_primal[i] = LP.OptimumVector()[i];
+  }
+  for (int i = 1; i <= A.NumRows(); i++) {
+    p_dual[i] = LP.DualVector()[i];
+  }
+  return true;
+}
+
 template <class T>
 void PrintProfileDetail(std::ostream &p_stream,
 			const MixedBehavProfile<T> &p_profile)
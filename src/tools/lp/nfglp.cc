@@ -23,8 +23,11 @@
 
 #include <unistd.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include "libgambit/libgambit.h"
 #include "liblinear/lpsolve.h"
+#include "liblinear/sparselp.h"
 
 using namespace Gambit;
 
@@ -155,7 +158,7 @@ void SolveStrategic(const Game &p_game)
     profile->SetStrategy(support.GetStrategy(2, i));
     for (int j = 1; j <= m; j++)  {
       profile->SetStrategy(support.GetStrategy(1, j));
-      A(i, j) = Rational(minpay) - profile->GetPayoff(1);
+      A(i, j) = minpay - (T) profile->GetPayoff(1);
     }
     A(i,m+1) = (T) 1;
   }
@@ -175,5 +178,123 @@ void SolveStrategic(const Game &p_game)
   }
 }
 
-template void SolveStrategic<double>(const Game &);
+//
+// Appends to p_strategies up to p_max of the strategies not already in
+// it whose regret exceeds p_tolerance, largest regret first.  Returns
+// the number appended.
+//
+static int GrowRestriction(Array<int> &p_strategies,
+			   const Vector<double> &p_regret,
+			   double p_tolerance, int p_max)
+{
+  std::vector<std::pair<double, int> > candidates;
+  for (int i = 1; i <= p_regret.Length(); i++) {
+    if (p_regret[i] > p_tolerance && !p_strategies.Contains(i)) {
+      candidates.push_back(std::make_pair(-p_regret[i], i));
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  int added = std::min(p_max, (int) candidates.size());
+  for (int i = 0; i < added; i++) {
+    p_strategies.Append(candidates[i].second);
+  }
+  return added;
+}
+
+//
+// In floating point, the LP is instead solved over a subset of player
+// 1's strategies, adding those with positive regret against player 2's
+// (dual) solution until there are none.  Each LP is solved
+// by the sparse revised simplex method, starting from the optimal
+// basis of the one before, which stays feasible as columns are added.
+//
+template<>
+void SolveStrategic<double>(const Game &p_game)
+{
+  StrategySupport support(p_game);
+
+  int m = support.NumStrategies(1);
+  int k = support.NumStrategies(2);
+
+  Matrix<double> payoff(k, m);
+  PureStrategyProfile profile = support.GetGame()->NewPureStrategyProfile();
+  for (int i = 1; i <= k; i++)  {
+    profile->SetStrategy(support.GetStrategy(2, i));
+    for (int j = 1; j <= m; j++)  {
+      profile->SetStrategy(support.GetStrategy(1, j));
+      payoff(i, j) = profile->GetPayoff(1);
+    }
+  }
+
+  double minpay = (double) (p_game->GetMinPayoff() - Rational(1));
+  double tolerance = 1.0e-9 * (1.0 + (double) (p_game->GetMaxPayoff() -
+					       p_game->GetMinPayoff()));
+
+  // The strategies of player 1 in the LP, and its optimal basis
+  Array<int> cols, basis;
+  cols.Append(1);
+  Array<double> primal(m+1), dual(k+1);
+  while (true) {
+    int s = cols.Length();
+    Matrix<double> A(1, k+1, 1, s+1);
+    Vector<double> b(1, k+1), c(1, s+1);
+    for (int i = 1; i <= k; i++) {
+      for (int j = 1; j <= s; j++) {
+	A(i, j) = minpay - payoff(i, cols[j]);
+      }
+      A(i, s+1) = 1.0;
+    }
+    for (int j = 1; j <= s; j++) {
+      A(k+1, j) = 1.0;
+    }
+    A(k+1, s+1) = 0.0;
+    b = 0.0;
+    b[k+1] = 1.0;
+    c = 0.0;
+    c[s+1] = 1.0;
+
+    SparseLPSolve LP(A, b, c, 1, basis);
+    if (!LP.IsFeasible() || !LP.IsBounded()) {
+      return;
+    }
+    for (int j = 1; j <= m; j++) {
+      primal[j] = 0.0;
+    }
+    for (int j = 1; j <= s; j++) {
+      primal[cols[j]] = LP.OptimumVector()[j];
+    }
+    for (int i = 1; i <= k; i++) {
+      dual[i] = LP.DualVector()[i];
+    }
+
+    Vector<double> regret(m);
+    double value = 0.0;
+    for (int j = 1; j <= m; j++) {
+      regret[j] = 0.0;
+      for (int i = 1; i <= k; i++) {
+	regret[j] += dual[i] * payoff(i, j);
+      }
+      value += primal[j] * regret[j];
+    }
+    for (int j = 1; j <= m; j++) {
+      regret[j] -= value;
+    }
+
+    // The number of strategies at most doubles at each step
+    int added = GrowRestriction(cols, regret, tolerance, s);
+    if (added == 0) {
+      break;
+    }
+    // The new columns are nonbasic; the last column moves past them
+    basis = LP.GetBasis();
+    for (int i = 1; i <= basis.Length(); i++) {
+      if (basis[i] == s+1) {
+	basis[i] = s+added+1;
+      }
+    }
+  }
+
+  PrintSolution(support, primal, dual);
+}
+
 template void SolveStrategic<Rational>(const Game &);